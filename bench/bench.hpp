@@ -0,0 +1,107 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_BENCH_HPP
+#define CTRX_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdio>
+
+namespace bench
+{
+// Keeps the compiler from optimizing away a value
+template<typename T>
+inline void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(static_cast<T const volatile&>(value));
+#endif
+}
+
+// Prints the median of the measured times per iteration
+inline auto report(char const* name, std::vector<double> ns_per_iteration) -> double
+{
+    std::sort(ns_per_iteration.begin(), ns_per_iteration.end());
+    double const median = ns_per_iteration[ns_per_iteration.size() / 2];
+    std::printf("%-48s %12.2f ns/iteration\n", name, median);
+    return median;
+}
+
+// Runs fn iterations times per sample and prints the median time per iteration over all samples
+template<typename Fn>
+inline auto run(char const* name, std::size_t iterations, Fn&& fn, std::size_t samples = 15) -> double
+{
+    std::vector<double> ns_per_iteration;
+    for (std::size_t s = 0; s < samples; ++s)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            fn(i);
+        auto const stop = std::chrono::steady_clock::now();
+        ns_per_iteration.push_back(std::chrono::duration<double, std::nano>(stop - start).count()
+                                   / static_cast<double>(iterations));
+    }
+    return report(name, std::move(ns_per_iteration));
+}
+
+// Like run, but runs fn iterations times on each of threads threads at once, and prints the median wall-clock time per
+// iteration of a single thread, which only grows with the number of threads if they contend
+template<typename Fn>
+inline auto run_parallel(char const* name,
+                         std::size_t threads,
+                         std::size_t iterations,
+                         Fn&&        fn,
+                         std::size_t samples = 15) -> double
+{
+    std::vector<double> ns_per_iteration;
+    for (std::size_t s = 0; s < samples; ++s)
+    {
+        std::vector<std::thread> workers;
+        auto const               start = std::chrono::steady_clock::now();
+        for (std::size_t t = 0; t < threads; ++t)
+            workers.emplace_back(
+                [&]
+                {
+                    for (std::size_t i = 0; i < iterations; ++i)
+                        fn(i);
+                });
+        for (auto& worker : workers)
+            worker.join();
+        auto const stop = std::chrono::steady_clock::now();
+        ns_per_iteration.push_back(std::chrono::duration<double, std::nano>(stop - start).count()
+                                   / static_cast<double>(iterations));
+    }
+    return report(name, std::move(ns_per_iteration));
+}
+} // namespace bench
+
+#endif // CTRX_BENCH_HPP
@@ -0,0 +1,112 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_MODE THROW
+#include "ctrx/checked_span.hpp"
+#include "ctrx/checked_vector.hpp"
+
+#include "bench.hpp"
+
+#include <numeric>
+#include <span>
+#include <vector>
+
+// Sums the first n elements, by index, with every access checked or not
+CTRX_DETAIL_NOINLINE auto sum_span(std::span<int const> span, std::size_t n) -> long
+{
+    long sum = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        sum += span[i];
+    return sum;
+}
+CTRX_DETAIL_NOINLINE auto sum_at(std::vector<int> const& vector, std::size_t n) -> long
+{
+    long sum = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        sum += vector.at(i);
+    return sum;
+}
+CTRX_DETAIL_NOINLINE auto sum_checked(ctrx::checked_span<int const> span, std::size_t n) -> long
+{
+    long sum = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        sum += span[i];
+    return sum;
+}
+// The range is checked once, and the loop runs unchecked
+CTRX_DETAIL_NOINLINE auto sum_checked_hoisted(ctrx::checked_span<int const> span, std::size_t n) -> long
+{
+    long sum = 0;
+    for (int value : span.first(n).unchecked())
+        sum += value;
+    return sum;
+}
+CTRX_DETAIL_NOINLINE auto sum_checked_range_for(ctrx::checked_vector<int> const& vector) -> long
+{
+    long sum = 0;
+    for (int value : vector)
+        sum += value;
+    return sum;
+}
+
+// Single accesses at unpredictable positions, where no check can be hoisted
+CTRX_DETAIL_NOINLINE auto element_span(std::span<int const> span, std::size_t i) -> int
+{
+    return span[i];
+}
+CTRX_DETAIL_NOINLINE auto element_at(std::vector<int> const& vector, std::size_t i) -> int
+{
+    return vector.at(i);
+}
+CTRX_DETAIL_NOINLINE auto element_checked(ctrx::checked_span<int const> span, std::size_t i) -> int
+{
+    return span[i];
+}
+
+auto main() -> int
+{
+    std::size_t constexpr n = 4096;
+    ctrx::checked_vector<int> const checked(n, 1);
+    std::vector<int> const&         vector = checked.unchecked();
+
+    bench::run("sum, std::span", 10'000, [&](std::size_t) { bench::do_not_optimize(sum_span(vector, n)); });
+    bench::run("sum, std::vector::at", 10'000, [&](std::size_t) { bench::do_not_optimize(sum_at(vector, n)); });
+    bench::run("sum, checked_span", 10'000, [&](std::size_t) { bench::do_not_optimize(sum_checked(checked, n)); });
+    bench::run("sum, checked_span (hoisted check)",
+               10'000,
+               [&](std::size_t) { bench::do_not_optimize(sum_checked_hoisted(checked, n)); });
+    bench::run("sum, checked_vector (range-for)",
+               10'000,
+               [&](std::size_t) { bench::do_not_optimize(sum_checked_range_for(checked)); });
+
+    auto const position = [](std::size_t i) { return (i * 2654435761u) % n; };
+    bench::run("element, std::span",
+               10'000'000,
+               [&](std::size_t i) { bench::do_not_optimize(element_span(vector, position(i))); });
+    bench::run("element, std::vector::at",
+               10'000'000,
+               [&](std::size_t i) { bench::do_not_optimize(element_at(vector, position(i))); });
+    bench::run("element, checked_span",
+               10'000'000,
+               [&](std::size_t i) { bench::do_not_optimize(element_checked(checked, position(i))); });
+}
@@ -0,0 +1,122 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_MODE THROW
+#include "ctrx/contracts.hpp"
+#include "ctrx/violation_info.hpp"
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+struct request
+{
+    int length;
+};
+
+// Rejects requests that are too long, in each of the ways a precondition violation can be reported to the caller
+CTRX_DETAIL_NOINLINE auto handle_throw(request const& r) -> int
+{
+    CTRX_PRECONDITION(r.length <= 1024, default, "request too long");
+    return r.length;
+}
+CTRX_DETAIL_NOINLINE auto handle_or_return(request const& r) -> int
+{
+    CTRX_PRECONDITION_OR_RETURN(-1, r.length <= 1024, default, "request too long");
+    return r.length;
+}
+#if defined(__cpp_lib_expected)
+CTRX_DETAIL_NOINLINE auto handle_or_unexpected(request const& r) -> std::expected<int, ctrx::violation_info>
+{
+    CTRX_PRECONDITION_OR_UNEXPECTED(r.length <= 1024, default, "request too long");
+    return r.length;
+}
+#endif
+
+// Returns whether the request was rejected
+auto rejected_throw(request const& r) -> bool
+{
+    try
+    {
+        bench::do_not_optimize(handle_throw(r));
+        return false;
+    }
+    catch (ctrx::precondition_violation const&)
+    {
+        return true;
+    }
+}
+auto rejected_or_return(request const& r) -> bool
+{
+    return handle_or_return(r) < 0;
+}
+#if defined(__cpp_lib_expected)
+auto rejected_or_unexpected(request const& r) -> bool
+{
+    return !handle_or_unexpected(r).has_value();
+}
+#endif
+
+template<auto Rejected>
+void run(char const* name, int length, std::size_t iterations)
+{
+    bench::run(name, iterations, [&](std::size_t) { bench::do_not_optimize(Rejected(request{length})); });
+}
+
+// Exceptions contend on the unwinder's locks when thrown from many threads at once, error returns don't
+template<auto Rejected>
+void run_parallel(char const* name, std::size_t threads, std::size_t iterations)
+{
+    bench::run_parallel(name,
+                        threads,
+                        iterations,
+                        [](std::size_t) { bench::do_not_optimize(Rejected(request{2048})); });
+}
+
+int main()
+{
+    run<rejected_throw>("accepted, exception", 100, 10'000'000);
+    run<rejected_or_return>("accepted, error return", 100, 10'000'000);
+#if defined(__cpp_lib_expected)
+    run<rejected_or_unexpected>("accepted, std::expected", 100, 10'000'000);
+#endif
+
+    run<rejected_throw>("rejected, exception", 2048, 100'000);
+    run<rejected_or_return>("rejected, error return", 2048, 10'000'000);
+#if defined(__cpp_lib_expected)
+    run<rejected_or_unexpected>("rejected, std::expected", 2048, 10'000'000);
+#endif
+
+    std::size_t const threads = std::clamp(std::thread::hardware_concurrency(), 2u, 8u);
+    std::printf("\n%zu threads:\n", threads);
+    run_parallel<rejected_throw>("rejected, exception", threads, 20'000);
+    run_parallel<rejected_or_return>("rejected, error return", threads, 2'000'000);
+#if defined(__cpp_lib_expected)
+    run_parallel<rejected_or_unexpected>("rejected, std::expected", threads, 2'000'000);
+#endif
+}
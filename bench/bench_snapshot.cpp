@@ -0,0 +1,94 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_MODE THROW
+#include "ctrx/snapshot.hpp"
+
+#include "bench.hpp"
+
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// Verifies that a read-only table isn't changed by a pass over it, by a copy that is compared afterwards, or by a
+// snapshot
+CTRX_DETAIL_NOINLINE auto sum_copied(std::vector<std::int64_t> const& table) -> std::int64_t
+{
+    std::vector<std::int64_t> const copy = table;
+    std::int64_t                    sum  = 0;
+    for (std::int64_t value : table)
+        sum += value;
+    CTRX_ASSERT(copy == table);
+    return sum;
+}
+CTRX_DETAIL_NOINLINE auto sum_snapshot(std::vector<std::int64_t> const& table) -> std::int64_t
+{
+    CTRX_SNAPSHOT(table);
+    std::int64_t sum = 0;
+    for (std::int64_t value : table)
+        sum += value;
+    CTRX_ASSERT_UNCHANGED(table);
+    return sum;
+}
+CTRX_DETAIL_NOINLINE auto sum_unchecked(std::vector<std::int64_t> const& table) -> std::int64_t
+{
+    std::int64_t sum = 0;
+    for (std::int64_t value : table)
+        sum += value;
+    return sum;
+}
+
+// In caches, copy and compare is about as fast as a snapshot, but beyond them, it takes more passes over memory
+auto run_all(char const* size_name, std::size_t bytes, std::size_t iterations) -> void
+{
+    std::vector<std::int64_t> table(bytes / sizeof(std::int64_t));
+    for (std::size_t i = 0; i < table.size(); ++i)
+        table[i] = static_cast<std::int64_t>(i) * 3;
+
+    auto const name = [size_name](char const* what) { return std::string(size_name) + " table, " + what; };
+    bench::run(name("unchecked").c_str(),
+               iterations,
+               [&](std::size_t) { bench::do_not_optimize(sum_unchecked(table)); });
+    bench::run(name("copy and compare").c_str(),
+               iterations,
+               [&](std::size_t) { bench::do_not_optimize(sum_copied(table)); });
+    bench::run(name("snapshot").c_str(),
+               iterations,
+               [&](std::size_t) { bench::do_not_optimize(sum_snapshot(table)); });
+    bench::run(name("portable checksum only").c_str(),
+               iterations,
+               [&](std::size_t)
+               {
+                   auto const* bytes = reinterpret_cast<unsigned char const*>(table.data());
+                   auto const  size  = table.size() * sizeof(std::int64_t);
+                   bench::do_not_optimize(ctrx::detail::crc32c_portable(~std::uint32_t{0}, bytes, size));
+               });
+}
+
+auto main() -> int
+{
+    run_all("1 MiB", std::size_t{1} << 20, 200);
+    run_all("64 MiB", std::size_t{64} << 20, 5);
+}
@@ -0,0 +1,74 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_MODE THROW
+#define CTRX_CONFIG_CAPTURE_STACKTRACE
+#include "ctrx/contracts.hpp"
+
+#include "bench.hpp"
+
+#include <string>
+
+CTRX_DETAIL_NOINLINE auto recurse(int depth) -> ctrx::raw_stacktrace
+{
+    if (depth == 0)
+        return ctrx::raw_stacktrace::capture();
+    auto trace = recurse(depth - 1);
+    bench::do_not_optimize(depth);
+    return trace;
+}
+
+CTRX_DETAIL_NOINLINE void violate(int depth)
+{
+    if (depth == 0)
+        CTRX_ASSERT(false);
+    else
+        violate(depth - 1);
+    bench::do_not_optimize(depth);
+}
+
+auto main() -> int
+{
+    for (int depth : {4, 16, 64})
+    {
+        std::string const name = "capture (stack depth " + std::to_string(depth) + ")";
+        bench::run(name.c_str(), 10'000, [&](std::size_t) { bench::do_not_optimize(recurse(depth)); });
+    }
+
+    auto const trace = recurse(16);
+    bench::run("symbolize (stack depth 16)", 100, [&](std::size_t) { bench::do_not_optimize(trace.to_string()); });
+
+    bench::run("throw and catch violation with stack trace",
+               10'000,
+               [](std::size_t)
+               {
+                   try
+                   {
+                       violate(16);
+                   }
+                   catch (ctrx::contract_violation const& e)
+                   {
+                       bench::do_not_optimize(e.stacktrace().size());
+                   }
+               });
+}
@@ -0,0 +1,68 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_MODE THROW
+#define CTRX_CONFIG_LEVEL AUDIT
+#include "ctrx/contracts.hpp"
+
+#include "bench.hpp"
+
+#include <vector>
+
+// A cheap check, so that the cost of deciding whether to check it dominates
+CTRX_DETAIL_NOINLINE auto element_o_1(std::vector<int> const& v, std::size_t i) -> int
+{
+    CTRX_PRECONDITION(i < v.size(), o_1);
+    return v[i];
+}
+CTRX_DETAIL_NOINLINE auto element_audit(std::vector<int> const& v, std::size_t i) -> int
+{
+    CTRX_PRECONDITION(i < v.size(), audit);
+    return v[i];
+}
+
+auto main() -> int
+{
+    std::vector<int> const v(1024, 1);
+    auto const             o_1   = [&](std::size_t i) { bench::do_not_optimize(element_o_1(v, i % v.size())); };
+    auto const             audit = [&](std::size_t i) { bench::do_not_optimize(element_audit(v, i % v.size())); };
+
+    bench::run("O(1) contract (no runtime lookup)", 10'000'000, o_1);
+    bench::run("audit contract, global maximum", 10'000'000, audit);
+    {
+        ctrx::thread_policy const policy{ctrx::cost::o_n2};
+        bench::run("audit contract, thread policy (checked)", 10'000'000, audit);
+    }
+    {
+        ctrx::thread_policy const policy{ctrx::cost::o_1};
+        bench::run("audit contract, thread policy (skipped)", 10'000'000, audit);
+    }
+
+    bench::run("global maximum lookup",
+               10'000'000,
+               [](std::size_t)
+               { bench::do_not_optimize(ctrx::detail::runtime_max_cost.load(std::memory_order_relaxed)); });
+    bench::run("thread-local maximum lookup",
+               10'000'000,
+               [](std::size_t) { bench::do_not_optimize(ctrx::detail::thread_max_cost); });
+}
@@ -0,0 +1,177 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// Violation storms: 1 to 64 threads violate contracts as fast as they can, reported by exception (THROW mode), by the
+// violation handler (HANDLER mode) and by error return. For each of them, prints the violations per second, the tail
+// latency of a violating call, and the scaling efficiency: the throughput relative to a single thread, divided by the
+// number of threads that can run at once. An efficiency well below 1 marks contention, such as the locks of the
+// unwinder when many threads throw at once.
+#define CTRX_CONFIG_MODE_PRECONDITION THROW
+#define CTRX_CONFIG_MODE_ASSERTION HANDLER
+#include "ctrx/contracts.hpp"
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+thread_local std::uint64_t handled = 0;
+} // namespace
+
+namespace ctrx
+{
+void handle_contract_violation(contract_type, std::string_view, std::source_location const&)
+{
+    ++handled;
+}
+} // namespace ctrx
+
+// Each of them violates its contract for every odd value
+CTRX_DETAIL_NOINLINE auto parse_throw(int value) -> int
+{
+    CTRX_PRECONDITION(value % 2 == 0, default, "odd value");
+    return value / 2;
+}
+CTRX_DETAIL_NOINLINE auto parse_handler(int value) -> int
+{
+    CTRX_ASSERT(value % 2 == 0, default, "odd value");
+    return value / 2;
+}
+CTRX_DETAIL_NOINLINE auto parse_or_return(int value) -> int
+{
+    CTRX_PRECONDITION_OR_RETURN(-1, value % 2 == 0, default, "odd value");
+    return value / 2;
+}
+
+auto violate_throw() -> bool
+{
+    try
+    {
+        bench::do_not_optimize(parse_throw(1));
+        return false;
+    }
+    catch (ctrx::precondition_violation const&)
+    {
+        return true;
+    }
+}
+auto violate_handler() -> bool
+{
+    auto const before = handled;
+    bench::do_not_optimize(parse_handler(1));
+    return handled != before;
+}
+auto violate_or_return() -> bool
+{
+    return parse_or_return(1) < 0;
+}
+
+struct storm_result
+{
+    double violations_per_second;
+    double p50;
+    double p99;
+    double p999;
+};
+
+// Runs violations violating calls, spread over threads that start at once, and times each of them
+template<auto Violate>
+auto storm(std::size_t threads, std::size_t violations) -> storm_result
+{
+    std::size_t const                iterations = violations / threads;
+    std::vector<std::vector<double>> latencies(threads, std::vector<double>(iterations));
+    std::latch                       start{static_cast<std::ptrdiff_t>(threads + 1)};
+    std::vector<std::thread>         workers;
+    for (std::size_t t = 0; t < threads; ++t)
+        workers.emplace_back(
+            [&, t]
+            {
+                auto& ns = latencies[t];
+                start.arrive_and_wait();
+                for (std::size_t i = 0; i < iterations; ++i)
+                {
+                    auto const before = std::chrono::steady_clock::now();
+                    bench::do_not_optimize(Violate());
+                    auto const after = std::chrono::steady_clock::now();
+                    ns[i]            = std::chrono::duration<double, std::nano>(after - before).count();
+                }
+            });
+    auto const begin = std::chrono::steady_clock::now();
+    start.arrive_and_wait();
+    for (auto& worker : workers)
+        worker.join();
+    auto const end = std::chrono::steady_clock::now();
+
+    std::vector<double> all;
+    all.reserve(iterations * threads);
+    for (auto const& ns : latencies)
+        all.insert(all.end(), ns.begin(), ns.end());
+    std::sort(all.begin(), all.end());
+    auto const percentile = [&](double p)
+    { return all[static_cast<std::size_t>(p * static_cast<double>(all.size() - 1))]; };
+    return {static_cast<double>(all.size()) / std::chrono::duration<double>(end - begin).count(),
+            percentile(0.5),
+            percentile(0.99),
+            percentile(0.999)};
+}
+
+template<auto Violate>
+void run(char const* name, std::size_t violations)
+{
+    std::size_t const cores  = std::max(1u, std::thread::hardware_concurrency());
+    double            single = 0.0;
+    for (std::size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        auto const result = storm<Violate>(threads, violations);
+        if (threads == 1)
+            single = result.violations_per_second;
+        double const efficiency = result.violations_per_second
+                                  / (single * static_cast<double>(std::min(threads, cores)));
+        std::printf("%-14s %2zu threads %12.0f violations/s   p50 %8.0f ns   p99 %8.0f ns   p99.9 %9.0f ns   "
+                    "efficiency %4.2f\n",
+                    name,
+                    threads,
+                    result.violations_per_second,
+                    result.p50,
+                    result.p99,
+                    result.p999,
+                    efficiency);
+    }
+}
+
+auto main() -> int
+{
+    std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+    run<violate_throw>("exception", 128 * 1024);
+    run<violate_handler>("handler", 2 * 1024 * 1024);
+    run<violate_or_return>("error return", 2 * 1024 * 1024);
+}
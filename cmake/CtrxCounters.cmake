@@ -0,0 +1,60 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Shared counters let a separate process, such as a monitoring agent, watch how often the contracts of a service are
+# evaluated and violated, without linking to it.
+#
+#   ctrx_add_shared_counters(<target>)
+#
+# Builds <target> with CTRX_CONFIG_SHARED_COUNTERS, and the reader ctrx-counters along with it. See
+# ctrx/shared_counters.hpp for the layout of the shared memory segment.
+
+set(CTRX_COUNTERS_TOOL_SOURCE ${CMAKE_CURRENT_LIST_DIR}/../tools/ctrx_counters.cpp CACHE INTERNAL "")
+set(CTRX_COUNTERS_INCLUDE_DIR ${CMAKE_CURRENT_LIST_DIR}/../include CACHE INTERNAL "")
+
+# shm_open is part of librt before glibc 2.34
+find_library(CTRX_RT_LIBRARY rt)
+mark_as_advanced(CTRX_RT_LIBRARY)
+
+function(ctrx_add_shared_counters target)
+    if (NOT TARGET ctrx-counters)
+        add_executable(ctrx-counters ${CTRX_COUNTERS_TOOL_SOURCE})
+        target_include_directories(ctrx-counters PRIVATE ${CTRX_COUNTERS_INCLUDE_DIR})
+        set_target_properties(ctrx-counters PROPERTIES
+                CXX_STANDARD 20
+                CXX_STANDARD_REQUIRED YES
+                CXX_EXTENSIONS NO
+        )
+        if (CTRX_RT_LIBRARY)
+            target_link_libraries(ctrx-counters PRIVATE ${CTRX_RT_LIBRARY})
+        endif ()
+    endif ()
+
+    find_package(Threads REQUIRED)
+    add_dependencies(${target} ctrx-counters)
+    target_compile_definitions(${target} PRIVATE CTRX_CONFIG_SHARED_COUNTERS)
+    target_link_libraries(${target} PRIVATE Threads::Threads)
+    if (CTRX_RT_LIBRARY)
+        target_link_libraries(${target} PRIVATE ${CTRX_RT_LIBRARY})
+    endif ()
+endfunction()
@@ -0,0 +1,67 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Site maps translate the site ids reported by builds with CTRX_CONFIG_STRIP_STRINGS back to the violated contracts.
+#
+#   ctrx_add_site_map(<target> [OUTPUT <file>] [SOURCES <file>...])
+#
+# Scans the sources of <target> (and any additional SOURCES, e.g. headers with contracts) after every build of it, and
+# writes the site map to OUTPUT, which defaults to the target's binary with the extension .ctrx-sites appended.
+
+set(CTRX_SITE_MAP_TOOL_SOURCE ${CMAKE_CURRENT_LIST_DIR}/../tools/ctrx_site_map.cpp CACHE INTERNAL "")
+set(CTRX_SITE_MAP_INCLUDE_DIR ${CMAKE_CURRENT_LIST_DIR}/../include CACHE INTERNAL "")
+
+function(ctrx_add_site_map target)
+    cmake_parse_arguments(PARSE_ARGV 1 CTRX_SITE_MAP "" "OUTPUT" "SOURCES")
+    if (NOT CTRX_SITE_MAP_OUTPUT)
+        set(CTRX_SITE_MAP_OUTPUT $<TARGET_FILE:${target}>.ctrx-sites)
+    endif ()
+
+    if (NOT TARGET ctrx-site-map)
+        add_executable(ctrx-site-map ${CTRX_SITE_MAP_TOOL_SOURCE})
+        target_include_directories(ctrx-site-map PRIVATE ${CTRX_SITE_MAP_INCLUDE_DIR})
+        set_target_properties(ctrx-site-map PROPERTIES
+                CXX_STANDARD 20
+                CXX_STANDARD_REQUIRED YES
+                CXX_EXTENSIONS NO
+        )
+    endif ()
+
+    get_target_property(target_sources ${target} SOURCES)
+    get_target_property(target_source_dir ${target} SOURCE_DIR)
+    set(sources)
+    foreach (source IN LISTS target_sources CTRX_SITE_MAP_SOURCES)
+        if (source MATCHES "^\\$<")
+            continue()
+        endif ()
+        get_filename_component(source ${source} ABSOLUTE BASE_DIR ${target_source_dir})
+        list(APPEND sources ${source})
+    endforeach ()
+
+    add_dependencies(${target} ctrx-site-map)
+    add_custom_command(TARGET ${target} POST_BUILD
+            COMMAND ctrx-site-map scan -o ${CTRX_SITE_MAP_OUTPUT} ${sources}
+            COMMENT "Generating ctrx site map of ${target}"
+            VERBATIM
+    )
+endfunction()
@@ -0,0 +1,73 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Profile-guided tiering demotes contracts that are expensive but never failed, based on the profiles recorded by
+# builds with CTRX_CONFIG_PROFILE (see CTRX_PROFILE_OUTPUT).
+#
+#   ctrx_add_tiering(<target> PROFILES <file>... [OUTPUT <header>] [LEVEL <level>] [MIN_SHARE <percent>]
+#                    [MIN_EVALUATIONS <n>])
+#
+# Generates the site overrides of the profiles with ctrx-tier whenever one of them changes, and builds <target> with
+# them. OUTPUT defaults to <target>.ctrx-overrides.hpp in the current binary directory; see ctrx-tier for the others.
+
+set(CTRX_TIER_TOOL_SOURCE ${CMAKE_CURRENT_LIST_DIR}/../tools/ctrx_tier.cpp CACHE INTERNAL "")
+set(CTRX_TIER_INCLUDE_DIR ${CMAKE_CURRENT_LIST_DIR}/../include CACHE INTERNAL "")
+
+function(ctrx_add_tiering target)
+    cmake_parse_arguments(PARSE_ARGV 1 CTRX_TIER "" "OUTPUT;LEVEL;MIN_SHARE;MIN_EVALUATIONS" "PROFILES")
+    if (NOT CTRX_TIER_PROFILES)
+        message(FATAL_ERROR "ctrx_add_tiering(${target}) needs at least one profile")
+    endif ()
+    if (NOT CTRX_TIER_OUTPUT)
+        set(CTRX_TIER_OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/${target}.ctrx-overrides.hpp)
+    endif ()
+    set(options)
+    if (CTRX_TIER_LEVEL)
+        list(APPEND options --level ${CTRX_TIER_LEVEL})
+    endif ()
+    if (CTRX_TIER_MIN_SHARE)
+        list(APPEND options --min-share ${CTRX_TIER_MIN_SHARE})
+    endif ()
+    if (CTRX_TIER_MIN_EVALUATIONS)
+        list(APPEND options --min-evaluations ${CTRX_TIER_MIN_EVALUATIONS})
+    endif ()
+
+    if (NOT TARGET ctrx-tier)
+        add_executable(ctrx-tier ${CTRX_TIER_TOOL_SOURCE})
+        target_include_directories(ctrx-tier PRIVATE ${CTRX_TIER_INCLUDE_DIR})
+        set_target_properties(ctrx-tier PROPERTIES
+                CXX_STANDARD 20
+                CXX_STANDARD_REQUIRED YES
+                CXX_EXTENSIONS NO
+        )
+    endif ()
+
+    add_custom_command(OUTPUT ${CTRX_TIER_OUTPUT}
+            COMMAND ctrx-tier -o ${CTRX_TIER_OUTPUT} ${options} ${CTRX_TIER_PROFILES}
+            DEPENDS ctrx-tier ${CTRX_TIER_PROFILES}
+            COMMENT "Generating ctrx site overrides of ${target}"
+            VERBATIM
+    )
+    target_sources(${target} PRIVATE ${CTRX_TIER_OUTPUT})
+    target_compile_definitions(${target} PRIVATE CTRX_CONFIG_SITE_OVERRIDES="${CTRX_TIER_OUTPUT}")
+endfunction()
@@ -0,0 +1,260 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef CTRX_ADAPTIVE_HPP
+#define CTRX_ADAPTIVE_HPP
+
+#include "ctrx/contract_type.hpp"
+#include "ctrx/detail/ticks.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <source_location>
+#include <vector>
+
+#include <cstdint>
+
+// Share of each thread's time that may be spent checking expensive contracts, in percent
+#if !defined(CTRX_CONFIG_ADAPTIVE_BUDGET)
+#define CTRX_CONFIG_ADAPTIVE_BUDGET 1
+#endif
+
+// Length of the windows in which the checking time is measured and the evaluation rates are adjusted, in ticks
+#if !defined(CTRX_CONFIG_ADAPTIVE_WINDOW)
+#define CTRX_CONFIG_ADAPTIVE_WINDOW (1u << 24)
+#endif
+
+// Number of calls per site, thread and window that are always checked, so that rarely executed sites always are
+#if !defined(CTRX_CONFIG_ADAPTIVE_MIN_CHECKS)
+#define CTRX_CONFIG_ADAPTIVE_MIN_CHECKS 2
+#endif
+
+namespace ctrx
+{
+// Current sampling state of an expensive contract site, merged over all threads
+struct adaptive_entry
+{
+    contract_type        type;
+    char const*          level;
+    char const*          condition;
+    std::source_location source_location;
+    std::uint_least64_t  calls;
+    std::uint_least64_t  evaluations;
+    double               rate; // evaluation probability most recently chosen for the site
+    double               cost; // ticks per evaluation (moving average)
+};
+
+namespace detail
+{
+// Shared state of a contract site; written only when it is evaluated, so skipped calls don't touch shared memory
+struct adaptive_site
+{
+    std::atomic<bool>                registered{false};
+    std::atomic<std::uint_least64_t> calls{0};
+    std::atomic<std::uint_least64_t> evaluations{0};
+    std::atomic<double>              rate{1.0};
+    std::atomic<double>              cost{0.0};
+};
+
+template<typename Tag>
+inline adaptive_site adaptive_site_v;
+
+// State of a contract site in a single thread
+struct adaptive_thread_site
+{
+    std::uint_least64_t window     = 0;
+    std::uint_least64_t calls      = 0; // in the current window
+    std::uint_least64_t unflushed  = 0; // calls not yet added to adaptive_site::calls
+    std::uint_least64_t threshold  = 0; // evaluation probability, scaled to 2^32
+    double              cost       = 0.0;
+    bool                cost_known = false;
+};
+
+template<typename Tag>
+inline thread_local adaptive_thread_site adaptive_thread_site_v;
+
+class adaptive_registry
+{
+  public:
+    [[nodiscard]] static inline auto instance() -> adaptive_registry&
+    {
+        static adaptive_registry registry;
+        return registry;
+    }
+
+    inline void register_site(adaptive_site& site, adaptive_entry const& info)
+    {
+        std::lock_guard lock{m_mutex};
+        if (site.registered.load(std::memory_order_relaxed))
+            return;
+        m_sites.emplace_back(&site, info);
+        site.registered.store(true, std::memory_order_release);
+    }
+
+    [[nodiscard]] inline auto report() -> std::vector<adaptive_entry>
+    {
+        std::lock_guard             lock{m_mutex};
+        std::vector<adaptive_entry> entries;
+        for (auto const& [site, info] : m_sites)
+        {
+            auto& entry       = entries.emplace_back(info);
+            entry.calls       = site->calls.load(std::memory_order_relaxed);
+            entry.evaluations = site->evaluations.load(std::memory_order_relaxed);
+            entry.rate        = site->rate.load(std::memory_order_relaxed);
+            entry.cost        = site->cost.load(std::memory_order_relaxed);
+        }
+        return entries;
+    }
+
+  private:
+    std::mutex                                             m_mutex;
+    std::vector<std::pair<adaptive_site*, adaptive_entry>> m_sites;
+};
+
+// Feedback controller of a thread. Each site is evaluated with a probability of allowance / (its cost per evaluation),
+// so expensive sites are sampled less than cheap ones. At the end of every window, the allowance is scaled by the
+// ratio of the budgeted and the actually spent checking time. It grows by at most a factor of two per window, to damp
+// oscillation, but shrinks quickly, as overspending is what the budget is meant to prevent.
+class adaptive_thread
+{
+  public:
+    static constexpr double budget = static_cast<double>(CTRX_CONFIG_ADAPTIVE_BUDGET) / 100.0;
+
+    [[nodiscard]] inline auto window() const noexcept -> std::uint_least64_t { return m_window; }
+    [[nodiscard]] inline auto allowance() const noexcept -> double { return m_allowance; }
+
+    // Uniformly distributed in [0, 2^32)
+    [[nodiscard]] inline auto next_random() noexcept -> std::uint_least64_t
+    {
+        m_random ^= m_random << 13;
+        m_random ^= m_random >> 7;
+        m_random ^= m_random << 17;
+        return m_random >> 32;
+    }
+
+    // Called for skipped evaluations; only looks at the clock every 256 calls, to end the window if it's over
+    inline void tick() noexcept
+    {
+        if ((++m_decisions & 255u) == 0)
+            advance(read_ticks());
+    }
+
+    inline void account(std::uint_least64_t start, std::uint_least64_t stop) noexcept
+    {
+        m_spent += stop - start;
+        advance(stop);
+    }
+
+  private:
+    inline void advance(std::uint_least64_t now) noexcept
+    {
+        if (m_window_start == 0)
+        {
+            m_window_start = now;
+            m_random       = reinterpret_cast<std::uintptr_t>(this) | 1u;
+            return;
+        }
+        auto const elapsed = now - m_window_start;
+        if (elapsed < CTRX_CONFIG_ADAPTIVE_WINDOW)
+            return;
+
+        double const target = budget * static_cast<double>(elapsed);
+        double const ratio  = m_spent == 0 ? 2.0 : target / static_cast<double>(m_spent);
+        m_allowance         = std::clamp(m_allowance * std::clamp(ratio, 1.0 / 64.0, 2.0), 1e-3, 1e12);
+        m_spent             = 0;
+        m_window_start      = now;
+        ++m_window;
+    }
+
+    std::uint_least64_t m_window       = 1;
+    std::uint_least64_t m_window_start = 0;
+    std::uint_least64_t m_spent        = 0;
+    std::uint_least64_t m_random       = 0x9e3779b97f4a7c15u;
+    std::uint_least32_t m_decisions    = 0;
+    double              m_allowance    = budget * CTRX_CONFIG_ADAPTIVE_WINDOW;
+};
+
+inline thread_local adaptive_thread adaptive_thread_v;
+
+// Conditions that were sampled where their state was captured, like the checks of a ctrx::snapshot. They cost nothing
+// if that was skipped, so they aren't sampled a second time.
+template<typename Condition>
+concept presampled = requires { typename Condition::sampled_at_capture; };
+
+// Evaluates a contract condition (via fn) with the evaluation probability of the site identified by Tag, and returns
+// an empty result if it was skipped
+template<typename Tag, typename Fn>
+inline auto adaptive_evaluation(contract_type               type,
+                                char const*                 level,
+                                char const*                 condition,
+                                std::source_location const& sloc,
+                                Fn&&                        fn) -> decltype(fn())
+{
+    auto& thread = adaptive_thread_v;
+    auto& local  = adaptive_thread_site_v<Tag>;
+    auto& site   = adaptive_site_v<Tag>;
+
+    ++local.unflushed;
+    if (local.window != thread.window()) [[unlikely]]
+    {
+        if (local.window == 0 && !site.registered.load(std::memory_order_acquire))
+            adaptive_registry::instance().register_site(site,
+                                                        adaptive_entry{type, level, condition, sloc, 0, 0, 1.0, 0.0});
+        local.window    = thread.window();
+        local.calls     = 0;
+        double const p  = local.cost_known ? std::min(1.0, thread.allowance() / std::max(local.cost, 1.0)) : 1.0;
+        local.threshold = static_cast<std::uint_least64_t>(p * 4294967296.0);
+        site.rate.store(p, std::memory_order_relaxed);
+    }
+    if (++local.calls > CTRX_CONFIG_ADAPTIVE_MIN_CHECKS && thread.next_random() >= local.threshold)
+    {
+        thread.tick();
+        return {};
+    }
+
+    auto const start  = read_ticks();
+    auto       result = fn();
+    auto const stop   = read_ticks();
+
+    auto const ticks = static_cast<double>(stop - start);
+    local.cost       = local.cost_known ? local.cost + (ticks - local.cost) / 8.0 : ticks;
+    local.cost_known = true;
+    site.calls.fetch_add(local.unflushed, std::memory_order_relaxed);
+    site.evaluations.fetch_add(1, std::memory_order_relaxed);
+    site.cost.store(local.cost, std::memory_order_relaxed);
+    local.unflushed = 0;
+    thread.account(start, stop);
+    return result;
+}
+} // namespace detail
+
+// Returns the sampling state of all expensive contract sites evaluated so far. Calls that were skipped are counted
+// once the site is evaluated again in the same thread.
+[[nodiscard]] inline auto adaptive_report() -> std::vector<adaptive_entry>
+{
+    return detail::adaptive_registry::instance().report();
+}
+} // namespace ctrx
+
+#endif // CTRX_ADAPTIVE_HPP
@@ -0,0 +1,319 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef CTRX_CHECKED_SPAN_HPP
+#define CTRX_CHECKED_SPAN_HPP
+
+#include "ctrx/contracts.hpp"
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/predicates.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+// Whether the bounds checks of the adapters are evaluated in this translation unit. If they aren't (OFF and ASSUME
+// mode, or OFF level), their iterators are plain pointers, so that they compile to exactly the unchecked access.
+#if CTRX_DETAIL_MODE_NUM(PRECONDITION) == CTRX_DETAIL_MODE_NUM_OFF                                                     \
+    || CTRX_DETAIL_MODE_NUM(PRECONDITION) == CTRX_DETAIL_MODE_NUM_ASSUME                                               \
+    || CTRX_DETAIL_LEVEL_NUM(PRECONDITION) == CTRX_DETAIL_LEVEL_NUM_OFF
+#define CTRX_DETAIL_CHECKED_ITERATORS 0
+#else
+#define CTRX_DETAIL_CHECKED_ITERATORS 1
+#endif
+
+namespace ctrx
+{
+// Within the configuration's own inline namespace, as the checks of these inline functions depend on it
+inline namespace CTRX_ABI_NAMESPACE
+{
+#if CTRX_DETAIL_CHECKED_ITERATORS
+// Random access iterator into [begin, end) that checks every dereference and every step against that range. Within a
+// range-for loop, the checks are implied by the loop condition and optimized away.
+template<typename T>
+class checked_iterator
+{
+  public:
+    using iterator_concept  = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::remove_cv_t<T>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
+
+    constexpr checked_iterator() noexcept = default;
+    constexpr checked_iterator(T* current, T* begin, T* end) noexcept
+        : m_current(current)
+        , m_begin(begin)
+        , m_end(end)
+    {
+    }
+    template<typename U>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+    constexpr checked_iterator(checked_iterator<U> const& other) noexcept
+        : m_current(other.m_current)
+        , m_begin(other.m_begin)
+        , m_end(other.m_end)
+    {
+    }
+
+    // The current position, without any check
+    [[nodiscard]] constexpr auto base() const noexcept -> T* { return m_current; }
+    // The beginning of the range the iterator is checked against
+    [[nodiscard]] constexpr auto range_begin() const noexcept -> T* { return m_begin; }
+
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator*() const -> T&
+    {
+        CTRX_PRECONDITION(m_current != m_end);
+        return *m_current;
+    }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator->() const -> T*
+    {
+        CTRX_PRECONDITION(m_current != m_end);
+        return m_current;
+    }
+    [[nodiscard]] constexpr auto operator[](difference_type n) const -> T& { return *(*this + n); }
+
+    CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator++() -> checked_iterator&
+    {
+        CTRX_PRECONDITION(m_current != m_end);
+        ++m_current;
+        return *this;
+    }
+    constexpr auto operator++(int) -> checked_iterator
+    {
+        auto const copy = *this;
+        ++*this;
+        return copy;
+    }
+    CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator--() -> checked_iterator&
+    {
+        CTRX_PRECONDITION(m_current != m_begin);
+        --m_current;
+        return *this;
+    }
+    constexpr auto operator--(int) -> checked_iterator
+    {
+        auto const copy = *this;
+        --*this;
+        return copy;
+    }
+    CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator+=(difference_type n) -> checked_iterator&
+    {
+        CTRX_PRECONDITION(ctrx::in_range(n, m_begin - m_current, m_end - m_current));
+        m_current += n;
+        return *this;
+    }
+    CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator-=(difference_type n) -> checked_iterator&
+    {
+        CTRX_PRECONDITION(ctrx::in_range(n, m_current - m_end, m_current - m_begin));
+        m_current -= n;
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr auto operator+(checked_iterator iter, difference_type n) -> checked_iterator
+    {
+        return iter += n;
+    }
+    [[nodiscard]] friend constexpr auto operator+(difference_type n, checked_iterator iter) -> checked_iterator
+    {
+        return iter += n;
+    }
+    [[nodiscard]] friend constexpr auto operator-(checked_iterator iter, difference_type n) -> checked_iterator
+    {
+        return iter -= n;
+    }
+    [[nodiscard]] friend constexpr auto operator-(checked_iterator const& lhs, checked_iterator const& rhs) noexcept
+        -> difference_type
+    {
+        return lhs.m_current - rhs.m_current;
+    }
+    [[nodiscard]] friend constexpr auto operator==(checked_iterator const& lhs, checked_iterator const& rhs) noexcept
+        -> bool
+    {
+        return lhs.m_current == rhs.m_current;
+    }
+    [[nodiscard]] friend constexpr auto operator<=>(checked_iterator const& lhs, checked_iterator const& rhs) noexcept
+        -> std::strong_ordering
+    {
+        return lhs.m_current <=> rhs.m_current;
+    }
+
+  private:
+    template<typename U>
+    friend class checked_iterator;
+
+    T* m_current = nullptr;
+    T* m_begin   = nullptr;
+    T* m_end     = nullptr;
+};
+#else
+template<typename T>
+using checked_iterator = T*;
+#endif
+
+// A std::span whose element access is checked by preconditions. The checks follow the configured precondition mode and
+// level; in OFF and ASSUME mode, it is exactly a std::span. Loops that shouldn't pay for a check per element can check
+// their range once instead, e.g. `for (auto& x : span.first(n).unchecked())`.
+template<typename T, std::size_t Extent = std::dynamic_extent>
+class checked_span;
+} // namespace CTRX_ABI_NAMESPACE
+
+namespace detail
+{
+template<typename T>
+inline constexpr bool is_checked_span = false;
+template<typename T, std::size_t Extent>
+inline constexpr bool is_checked_span<checked_span<T, Extent>> = true;
+} // namespace detail
+
+inline namespace CTRX_ABI_NAMESPACE
+{
+template<typename T, std::size_t Extent>
+class checked_span
+{
+  public:
+    using element_type     = T;
+    using value_type       = std::remove_cv_t<T>;
+    using size_type        = std::size_t;
+    using difference_type  = std::ptrdiff_t;
+    using pointer          = T*;
+    using const_pointer    = T const*;
+    using reference        = T&;
+    using const_reference  = T const&;
+    using iterator         = checked_iterator<T>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    static constexpr std::size_t extent = Extent;
+
+    constexpr checked_span() noexcept
+        requires(Extent == 0 || Extent == std::dynamic_extent)
+    = default;
+    constexpr checked_span(std::span<T, Extent> span) noexcept
+        : m_span(span)
+    {
+    }
+    // Any range with contiguous data(), e.g. containers, arrays and checked_vector. Like std::span, only views into
+    // const elements can be created from temporaries.
+    template<typename Range>
+        requires(!detail::is_checked_span<std::remove_cvref_t<Range>>
+                 && (std::is_lvalue_reference_v<Range> || std::is_const_v<T>)
+                 && requires(Range& range) {
+                        { std::ranges::data(range) } -> std::convertible_to<T*>;
+                        std::ranges::size(range);
+                    })
+    constexpr explicit(Extent != std::dynamic_extent) checked_span(Range&& range) noexcept
+        : m_span(std::ranges::data(range), std::ranges::size(range))
+    {
+    }
+    template<typename U, std::size_t OtherExtent>
+        requires(!std::is_same_v<checked_span<U, OtherExtent>, checked_span>
+                 && std::is_constructible_v<std::span<T, Extent>, std::span<U, OtherExtent>>)
+    constexpr explicit(Extent != std::dynamic_extent && OtherExtent == std::dynamic_extent)
+        checked_span(checked_span<U, OtherExtent> other) noexcept
+        : m_span(other.unchecked())
+    {
+    }
+    constexpr explicit(Extent != std::dynamic_extent) checked_span(T* data, size_type count) noexcept
+        : m_span(data, count)
+    {
+    }
+
+    // The underlying std::span, whose element access isn't checked
+    [[nodiscard]] constexpr auto unchecked() const noexcept -> std::span<T, Extent> { return m_span; }
+
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator[](size_type index) const -> T&
+    {
+        CTRX_PRECONDITION(ctrx::valid_index(index, m_span.size()));
+        return m_span[index];
+    }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto front() const -> T&
+    {
+        CTRX_PRECONDITION(!m_span.empty());
+        return m_span.front();
+    }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto back() const -> T&
+    {
+        CTRX_PRECONDITION(!m_span.empty());
+        return m_span.back();
+    }
+    [[nodiscard]] constexpr auto data() const noexcept -> T* { return m_span.data(); }
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type { return m_span.size(); }
+    [[nodiscard]] constexpr auto size_bytes() const noexcept -> size_type { return m_span.size_bytes(); }
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_span.empty(); }
+
+    [[nodiscard]] constexpr auto first(size_type count) const -> checked_span<T>
+    {
+        CTRX_PRECONDITION(count <= m_span.size());
+        return m_span.first(count);
+    }
+    [[nodiscard]] constexpr auto last(size_type count) const -> checked_span<T>
+    {
+        CTRX_PRECONDITION(count <= m_span.size());
+        return m_span.last(count);
+    }
+    [[nodiscard]] constexpr auto subspan(size_type offset, size_type count = std::dynamic_extent) const
+        -> checked_span<T>
+    {
+        CTRX_PRECONDITION(offset <= m_span.size());
+        CTRX_PRECONDITION(count == std::dynamic_extent || count <= m_span.size() - offset);
+        return m_span.subspan(offset, count);
+    }
+
+    [[nodiscard]] constexpr auto begin() const noexcept -> iterator { return make_iterator(m_span.data()); }
+    [[nodiscard]] constexpr auto end() const noexcept -> iterator
+    {
+        return make_iterator(m_span.data() + m_span.size());
+    }
+    [[nodiscard]] constexpr auto rbegin() const noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+    [[nodiscard]] constexpr auto rend() const noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+
+  private:
+    [[nodiscard]] constexpr auto make_iterator(T* position) const noexcept -> iterator
+    {
+#if CTRX_DETAIL_CHECKED_ITERATORS
+        return iterator{position, m_span.data(), m_span.data() + m_span.size()};
+#else
+        return position;
+#endif
+    }
+
+    std::span<T, Extent> m_span;
+};
+
+template<typename T, std::size_t Extent>
+checked_span(std::span<T, Extent>) -> checked_span<T, Extent>;
+template<typename T, std::size_t N>
+checked_span(T (&)[N]) -> checked_span<T, N>;
+template<typename Range>
+checked_span(Range&&) -> checked_span<std::remove_reference_t<std::ranges::range_reference_t<Range>>>;
+template<typename T>
+checked_span(T*, std::size_t) -> checked_span<T>;
+} // namespace CTRX_ABI_NAMESPACE
+} // namespace ctrx
+
+#endif // CTRX_CHECKED_SPAN_HPP
@@ -0,0 +1,274 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef CTRX_CHECKED_VECTOR_HPP
+#define CTRX_CHECKED_VECTOR_HPP
+
+#include "ctrx/checked_span.hpp"
+#include "ctrx/contracts.hpp"
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/predicates.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ctrx
+{
+// Within the configuration's own inline namespace, as the checks of these inline functions depend on it
+inline namespace CTRX_ABI_NAMESPACE
+{
+// A std::vector whose element access is checked by preconditions, like checked_span. Its iterators are checked against
+// the elements at the time they were obtained; like those of std::vector, they are invalidated by any reallocation.
+// Converts to checked_span, and unchecked() gives access to the std::vector itself.
+template<typename T, typename Allocator = std::allocator<T>>
+class checked_vector
+{
+  public:
+    using vector_type            = std::vector<T, Allocator>;
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = typename vector_type::size_type;
+    using difference_type        = typename vector_type::difference_type;
+    using pointer                = typename vector_type::pointer;
+    using const_pointer          = typename vector_type::const_pointer;
+    using reference              = T&;
+    using const_reference        = T const&;
+    using iterator               = checked_iterator<T>;
+    using const_iterator         = checked_iterator<T const>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    constexpr checked_vector() = default;
+    constexpr checked_vector(vector_type vector) noexcept
+        : m_vector(std::move(vector))
+    {
+    }
+    constexpr checked_vector(std::initializer_list<T> init, Allocator const& allocator = Allocator())
+        : m_vector(init, allocator)
+    {
+    }
+    // Any of the constructors of std::vector
+    template<typename... Args>
+        requires(sizeof...(Args) > 0 && std::is_constructible_v<vector_type, Args&&...>)
+    constexpr explicit checked_vector(Args&&... args)
+        : m_vector(std::forward<Args>(args)...)
+    {
+    }
+
+    // The underlying std::vector, whose element access isn't checked
+    [[nodiscard]] constexpr auto unchecked() noexcept -> vector_type& { return m_vector; }
+    [[nodiscard]] constexpr auto unchecked() const noexcept -> vector_type const& { return m_vector; }
+
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator[](size_type index) -> T&
+    {
+        CTRX_PRECONDITION(ctrx::valid_index(index, m_vector.size()));
+        return m_vector[index];
+    }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto operator[](size_type index) const -> T const&
+    {
+        CTRX_PRECONDITION(ctrx::valid_index(index, m_vector.size()));
+        return m_vector[index];
+    }
+    [[nodiscard]] constexpr auto at(size_type index) -> T& { return m_vector.at(index); }
+    [[nodiscard]] constexpr auto at(size_type index) const -> T const& { return m_vector.at(index); }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto front() -> T&
+    {
+        CTRX_PRECONDITION(!m_vector.empty());
+        return m_vector.front();
+    }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto front() const -> T const&
+    {
+        CTRX_PRECONDITION(!m_vector.empty());
+        return m_vector.front();
+    }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto back() -> T&
+    {
+        CTRX_PRECONDITION(!m_vector.empty());
+        return m_vector.back();
+    }
+    [[nodiscard]] CTRX_DETAIL_ALWAYS_INLINE constexpr auto back() const -> T const&
+    {
+        CTRX_PRECONDITION(!m_vector.empty());
+        return m_vector.back();
+    }
+    [[nodiscard]] constexpr auto data() noexcept -> T* { return m_vector.data(); }
+    [[nodiscard]] constexpr auto data() const noexcept -> T const* { return m_vector.data(); }
+
+    [[nodiscard]] constexpr auto begin() noexcept -> iterator
+    {
+        return make_iterator(std::to_address(m_vector.begin()));
+    }
+    [[nodiscard]] constexpr auto begin() const noexcept -> const_iterator
+    {
+        return make_iterator(std::to_address(m_vector.begin()));
+    }
+    [[nodiscard]] constexpr auto end() noexcept -> iterator { return make_iterator(std::to_address(m_vector.end())); }
+    [[nodiscard]] constexpr auto end() const noexcept -> const_iterator
+    {
+        return make_iterator(std::to_address(m_vector.end()));
+    }
+    [[nodiscard]] constexpr auto cbegin() const noexcept -> const_iterator { return begin(); }
+    [[nodiscard]] constexpr auto cend() const noexcept -> const_iterator { return end(); }
+    [[nodiscard]] constexpr auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+    [[nodiscard]] constexpr auto rbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{end()};
+    }
+    [[nodiscard]] constexpr auto rend() noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+    [[nodiscard]] constexpr auto rend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{begin()};
+    }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_vector.empty(); }
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type { return m_vector.size(); }
+    [[nodiscard]] constexpr auto max_size() const noexcept -> size_type { return m_vector.max_size(); }
+    [[nodiscard]] constexpr auto capacity() const noexcept -> size_type { return m_vector.capacity(); }
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> Allocator { return m_vector.get_allocator(); }
+    constexpr void reserve(size_type capacity) { m_vector.reserve(capacity); }
+    constexpr void shrink_to_fit() { m_vector.shrink_to_fit(); }
+
+    constexpr void clear() noexcept { m_vector.clear(); }
+    constexpr void resize(size_type count) { m_vector.resize(count); }
+    constexpr void resize(size_type count, T const& value) { m_vector.resize(count, value); }
+    template<typename... Args>
+    constexpr void assign(Args&&... args)
+    {
+        m_vector.assign(std::forward<Args>(args)...);
+    }
+    constexpr void push_back(T const& value) { m_vector.push_back(value); }
+    constexpr void push_back(T&& value) { m_vector.push_back(std::move(value)); }
+    template<typename... Args>
+    constexpr auto emplace_back(Args&&... args) -> T&
+    {
+        return m_vector.emplace_back(std::forward<Args>(args)...);
+    }
+    constexpr void pop_back()
+    {
+        CTRX_PRECONDITION(!m_vector.empty());
+        m_vector.pop_back();
+    }
+    template<typename... Args>
+    constexpr auto insert(const_iterator position, Args&&... args) -> iterator
+    {
+        auto const offset = insertion_offset(position);
+        m_vector.insert(m_vector.begin() + offset, std::forward<Args>(args)...);
+        return begin() + offset;
+    }
+    template<typename... Args>
+    constexpr auto emplace(const_iterator position, Args&&... args) -> iterator
+    {
+        auto const offset = insertion_offset(position);
+        m_vector.emplace(m_vector.begin() + offset, std::forward<Args>(args)...);
+        return begin() + offset;
+    }
+    constexpr auto erase(const_iterator position) -> iterator
+    {
+        CTRX_PRECONDITION(owns(position));
+        auto const offset = position - cbegin();
+        CTRX_PRECONDITION(ctrx::valid_index(offset, m_vector.size()));
+        if (!erasable(offset, 1))
+            return end();
+        m_vector.erase(m_vector.begin() + offset);
+        return begin() + offset;
+    }
+    constexpr auto erase(const_iterator first, const_iterator last) -> iterator
+    {
+        CTRX_PRECONDITION(owns(last));
+        auto const offset = insertion_offset(first);
+        auto const count  = last - first;
+        CTRX_PRECONDITION(ctrx::in_range(count, 0, static_cast<difference_type>(m_vector.size()) - offset));
+        if (!erasable(offset, count))
+            return end();
+        m_vector.erase(m_vector.begin() + offset, m_vector.begin() + offset + count);
+        return begin() + offset;
+    }
+    constexpr void swap(checked_vector& other) noexcept { m_vector.swap(other.m_vector); }
+    friend constexpr void swap(checked_vector& lhs, checked_vector& rhs) noexcept { lhs.swap(rhs); }
+
+    [[nodiscard]] friend constexpr auto operator==(checked_vector const& lhs, checked_vector const& rhs) -> bool
+    {
+        return lhs.m_vector == rhs.m_vector;
+    }
+    [[nodiscard]] friend constexpr auto operator<=>(checked_vector const& lhs, checked_vector const& rhs)
+    {
+        return lhs.m_vector <=> rhs.m_vector;
+    }
+
+  private:
+    // Whether an iterator was obtained from this vector (since its last reallocation). Only checked iterators know
+    // their range; its end isn't compared, as iterators stay valid if elements are appended without reallocating.
+    [[nodiscard]] constexpr auto owns([[maybe_unused]] const_iterator position) const noexcept -> bool
+    {
+#if CTRX_DETAIL_CHECKED_ITERATORS
+        return position.range_begin() == std::to_address(m_vector.cbegin());
+#else
+        return true;
+#endif
+    }
+
+    // Whether count elements can be erased at offset. Violated preconditions may return (e.g. in HANDLER mode), so if
+    // they are checked, an invalid range erases nothing instead of moving elements from beyond the end.
+    [[nodiscard]] constexpr auto erasable([[maybe_unused]] difference_type offset,
+                                          [[maybe_unused]] difference_type count) const noexcept -> bool
+    {
+#if CTRX_DETAIL_CHECKED_ITERATORS
+        auto const size = static_cast<difference_type>(m_vector.size());
+        return offset >= 0 && count >= 0 && offset <= size - count;
+#else
+        return true;
+#endif
+    }
+
+    // Offset of an iterator at which elements may be inserted, i.e. one in [begin, end]
+    [[nodiscard]] constexpr auto insertion_offset(const_iterator position) const -> difference_type
+    {
+        CTRX_PRECONDITION(owns(position));
+        auto const offset = position - cbegin();
+        CTRX_PRECONDITION(ctrx::in_range(offset, 0, static_cast<difference_type>(m_vector.size())));
+        return offset;
+    }
+
+    template<typename U>
+    [[nodiscard]] constexpr auto make_iterator(U* position) const noexcept -> checked_iterator<U>
+    {
+#if CTRX_DETAIL_CHECKED_ITERATORS
+        auto& vector = const_cast<vector_type&>(m_vector);
+        return checked_iterator<U>{position, std::to_address(vector.begin()), std::to_address(vector.end())};
+#else
+        return position;
+#endif
+    }
+
+    vector_type m_vector;
+};
+} // namespace CTRX_ABI_NAMESPACE
+} // namespace ctrx
+
+#endif // CTRX_CHECKED_VECTOR_HPP
@@ -0,0 +1,91 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_CONFIGURATION_HPP
+#define CTRX_CONFIGURATION_HPP
+
+#include "ctrx/contracts.hpp"
+
+#include <string_view>
+
+namespace ctrx
+{
+// Effective mode and level of every contract type, e.g. {"THROW", "DEFAULT"}
+struct configuration
+{
+    struct contract
+    {
+        std::string_view mode;
+        std::string_view level;
+
+        friend constexpr auto operator==(contract const&, contract const&) -> bool = default;
+    };
+
+    contract precondition;
+    contract postcondition;
+    contract assertion;
+    contract invariant;
+
+    friend constexpr auto operator==(configuration const&, configuration const&) -> bool = default;
+};
+
+namespace detail
+{
+// Indexed by CTRX_DETAIL_MODE_NUM_* and CTRX_DETAIL_LEVEL_NUM_*
+inline constexpr std::string_view mode_names[] =
+    {"", "OFF", "ASSERT", "ASSUME", "THROW", "TERMINATE", "HANDLER", "FUZZ"};
+inline constexpr std::string_view level_names[] =
+    {"", "OFF", "DEFAULT", "AUDIT", "AXIOM", "O_1", "O_LOG_N", "O_N", "O_N_LOG_N", "O_N2"};
+
+[[nodiscard]] constexpr auto contract_configuration(int mode, int level) noexcept -> configuration::contract
+{
+    return {mode_names[mode], level_names[level]};
+}
+} // namespace detail
+
+// Within the configuration's own inline namespace, so that each differently configured translation unit (and thereby
+// library) gets the answer of its own configuration, even though the function is inline
+inline namespace CTRX_ABI_NAMESPACE
+{
+[[nodiscard]] constexpr auto build_configuration() noexcept -> configuration
+{
+    return {
+        detail::contract_configuration(CTRX_DETAIL_MODE_NUM(PRECONDITION), CTRX_DETAIL_LEVEL_NUM(PRECONDITION)),
+        detail::contract_configuration(CTRX_DETAIL_MODE_NUM(POSTCONDITION), CTRX_DETAIL_LEVEL_NUM(POSTCONDITION)),
+        detail::contract_configuration(CTRX_DETAIL_MODE_NUM(ASSERTION), CTRX_DETAIL_LEVEL_NUM(ASSERTION)),
+        detail::contract_configuration(CTRX_DETAIL_MODE_NUM(INVARIANT), CTRX_DETAIL_LEVEL_NUM(INVARIANT)),
+    };
+}
+} // namespace CTRX_ABI_NAMESPACE
+} // namespace ctrx
+
+// Defines a function NAME() returning the configuration of the current translation unit. Exported from a (shared)
+// library, it tells its users which configuration the library was built with.
+#define CTRX_EXPORT_CONFIGURATION(NAME)                                                                                \
+    auto NAME() noexcept -> ::ctrx::configuration                                                                      \
+    {                                                                                                                  \
+        return ::ctrx::build_configuration();                                                                          \
+    }
+
+#endif // CTRX_CONFIGURATION_HPP
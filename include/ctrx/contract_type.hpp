@@ -32,6 +32,7 @@ enum class contract_type
     precondition,
     postcondition,
     assertion,
+    invariant,
 };
 }
 
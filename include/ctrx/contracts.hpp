@@ -39,8 +39,65 @@
 #define CTRX_DETAIL_STRINGIFY(A) #A
 #define CTRX_DETAIL_STRINGIFY2(A) CTRX_DETAIL_STRINGIFY(A)
 
-// Allow macro overloading based on argument count
-#define CTRX_DETAIL_GET_OVERLOADED_MACRO_3(ARG1, ARG2, ARG3, NAME, ...) NAME
+// Count variadic arguments (up to 16)
+#define CTRX_DETAIL_NARGS(...)                                                                                         \
+    CTRX_DETAIL_NARGS_IMPL(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, )
+#define CTRX_DETAIL_NARGS_IMPL(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, N, ...) N
+
+// Allow macro overloading based on argument count: condition, [level], [message], followed by any format arguments.
+// Yields the suffix of the overload, i.e. 2, 3, 4 or FMT.
+#define CTRX_DETAIL_OVERLOAD(...) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_OVERLOAD_, CTRX_DETAIL_NARGS(__VA_ARGS__))
+#define CTRX_DETAIL_OVERLOAD_1 2
+#define CTRX_DETAIL_OVERLOAD_2 3
+#define CTRX_DETAIL_OVERLOAD_3 4
+#define CTRX_DETAIL_OVERLOAD_4 FMT
+#define CTRX_DETAIL_OVERLOAD_5 FMT
+#define CTRX_DETAIL_OVERLOAD_6 FMT
+#define CTRX_DETAIL_OVERLOAD_7 FMT
+#define CTRX_DETAIL_OVERLOAD_8 FMT
+#define CTRX_DETAIL_OVERLOAD_9 FMT
+#define CTRX_DETAIL_OVERLOAD_10 FMT
+#define CTRX_DETAIL_OVERLOAD_11 FMT
+#define CTRX_DETAIL_OVERLOAD_12 FMT
+#define CTRX_DETAIL_OVERLOAD_13 FMT
+#define CTRX_DETAIL_OVERLOAD_14 FMT
+#define CTRX_DETAIL_OVERLOAD_15 FMT
+#define CTRX_DETAIL_OVERLOAD_16 FMT
+
+// Apply MACRO(ARG1, ARG2, ARG3, INDEX, X) to every X in the variadic arguments (up to 16). INDEX counts down to 1.
+#define CTRX_DETAIL_FOR_EACH(MACRO, ARG1, ARG2, ARG3, ...)                                                             \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_FOR_EACH_, CTRX_DETAIL_NARGS(__VA_ARGS__))(MACRO, ARG1, ARG2, ARG3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_1(M, A1, A2, A3, X) M(A1, A2, A3, 1, X)
+#define CTRX_DETAIL_FOR_EACH_2(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 2, X) CTRX_DETAIL_FOR_EACH_1(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_3(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 3, X) CTRX_DETAIL_FOR_EACH_2(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_4(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 4, X) CTRX_DETAIL_FOR_EACH_3(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_5(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 5, X) CTRX_DETAIL_FOR_EACH_4(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_6(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 6, X) CTRX_DETAIL_FOR_EACH_5(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_7(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 7, X) CTRX_DETAIL_FOR_EACH_6(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_8(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 8, X) CTRX_DETAIL_FOR_EACH_7(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_9(M, A1, A2, A3, X, ...)                                                                  \
+    M(A1, A2, A3, 9, X) CTRX_DETAIL_FOR_EACH_8(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_10(M, A1, A2, A3, X, ...)                                                                 \
+    M(A1, A2, A3, 10, X) CTRX_DETAIL_FOR_EACH_9(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_11(M, A1, A2, A3, X, ...)                                                                 \
+    M(A1, A2, A3, 11, X) CTRX_DETAIL_FOR_EACH_10(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_12(M, A1, A2, A3, X, ...)                                                                 \
+    M(A1, A2, A3, 12, X) CTRX_DETAIL_FOR_EACH_11(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_13(M, A1, A2, A3, X, ...)                                                                 \
+    M(A1, A2, A3, 13, X) CTRX_DETAIL_FOR_EACH_12(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_14(M, A1, A2, A3, X, ...)                                                                 \
+    M(A1, A2, A3, 14, X) CTRX_DETAIL_FOR_EACH_13(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_15(M, A1, A2, A3, X, ...)                                                                 \
+    M(A1, A2, A3, 15, X) CTRX_DETAIL_FOR_EACH_14(M, A1, A2, A3, __VA_ARGS__)
+#define CTRX_DETAIL_FOR_EACH_16(M, A1, A2, A3, X, ...)                                                                 \
+    M(A1, A2, A3, 16, X) CTRX_DETAIL_FOR_EACH_15(M, A1, A2, A3, __VA_ARGS__)
 
 // Check code validity in an unevaluated context
 #define CTRX_DETAIL_CHECK_CODE_VALIDITY(...) (void)sizeof(__VA_ARGS__)
@@ -56,6 +113,7 @@
 #define CTRX_DETAIL_MODE_NUM_THROW 4
 #define CTRX_DETAIL_MODE_NUM_TERMINATE 5
 #define CTRX_DETAIL_MODE_NUM_HANDLER 6
+#define CTRX_DETAIL_MODE_NUM_FUZZ 7
 
 #define CTRX_DETAIL_MODE_NUM_off CTRX_DETAIL_MODE_NUM_OFF
 #define CTRX_DETAIL_MODE_NUM_assert CTRX_DETAIL_MODE_NUM_ASSERT
@@ -63,6 +121,7 @@
 #define CTRX_DETAIL_MODE_NUM_throw CTRX_DETAIL_MODE_NUM_THROW
 #define CTRX_DETAIL_MODE_NUM_terminate CTRX_DETAIL_MODE_NUM_TERMINATE
 #define CTRX_DETAIL_MODE_NUM_handler CTRX_DETAIL_MODE_NUM_HANDLER
+#define CTRX_DETAIL_MODE_NUM_fuzz CTRX_DETAIL_MODE_NUM_FUZZ
 
 // ------------------------------------------------------
 // Levels
@@ -73,16 +132,73 @@
 #define CTRX_DETAIL_LEVEL_NUM_DEFAULT 2
 #define CTRX_DETAIL_LEVEL_NUM_AUDIT 3
 #define CTRX_DETAIL_LEVEL_NUM_AXIOM 4
+#define CTRX_DETAIL_LEVEL_NUM_O_1 5
+#define CTRX_DETAIL_LEVEL_NUM_O_LOG_N 6
+#define CTRX_DETAIL_LEVEL_NUM_O_N 7
+#define CTRX_DETAIL_LEVEL_NUM_O_N_LOG_N 8
+#define CTRX_DETAIL_LEVEL_NUM_O_N2 9
 
 #define CTRX_DETAIL_LEVEL_NUM_off CTRX_DETAIL_LEVEL_NUM_OFF
 #define CTRX_DETAIL_LEVEL_NUM_default CTRX_DETAIL_LEVEL_NUM_DEFAULT
 #define CTRX_DETAIL_LEVEL_NUM_audit CTRX_DETAIL_LEVEL_NUM_AUDIT
 #define CTRX_DETAIL_LEVEL_NUM_axiom CTRX_DETAIL_LEVEL_NUM_AXIOM
+#define CTRX_DETAIL_LEVEL_NUM_o_1 CTRX_DETAIL_LEVEL_NUM_O_1
+#define CTRX_DETAIL_LEVEL_NUM_o_log_n CTRX_DETAIL_LEVEL_NUM_O_LOG_N
+#define CTRX_DETAIL_LEVEL_NUM_o_n CTRX_DETAIL_LEVEL_NUM_O_N
+#define CTRX_DETAIL_LEVEL_NUM_o_n_log_n CTRX_DETAIL_LEVEL_NUM_O_N_LOG_N
+#define CTRX_DETAIL_LEVEL_NUM_o_n2 CTRX_DETAIL_LEVEL_NUM_O_N2
+
+// Cost tiers, i.e. the complexity class of contract checks: O(1), O(log n), O(n), O(n log n) and O(n²). Contracts of
+// the classic levels are tiered as well: DEFAULT checks are O(1), AUDIT checks may be arbitrarily expensive, and AXIOM
+// checks are never evaluated.
+#define CTRX_DETAIL_TIER_DEFAULT 1
+#define CTRX_DETAIL_TIER_AUDIT 5
+#define CTRX_DETAIL_TIER_AXIOM 6
+#define CTRX_DETAIL_TIER_O_1 1
+#define CTRX_DETAIL_TIER_O_LOG_N 2
+#define CTRX_DETAIL_TIER_O_N 3
+#define CTRX_DETAIL_TIER_O_N_LOG_N 4
+#define CTRX_DETAIL_TIER_O_N2 5
+
+// The configured level of a contract type enables all contracts up to a maximum tier. DEFAULT enables everything that
+// is cheap compared to the function it's in, i.e. up to O(log n); AUDIT (and AXIOM) enable everything.
+#define CTRX_DETAIL_MAX_TIER_OFF 0
+#define CTRX_DETAIL_MAX_TIER_DEFAULT 2
+#define CTRX_DETAIL_MAX_TIER_AUDIT 5
+#define CTRX_DETAIL_MAX_TIER_AXIOM 5
+#define CTRX_DETAIL_MAX_TIER_O_1 1
+#define CTRX_DETAIL_MAX_TIER_O_LOG_N 2
+#define CTRX_DETAIL_MAX_TIER_O_N 3
+#define CTRX_DETAIL_MAX_TIER_O_N_LOG_N 4
+#define CTRX_DETAIL_MAX_TIER_O_N2 5
+
+#define CTRX_DETAIL_MAX_TIER_off CTRX_DETAIL_MAX_TIER_OFF
+#define CTRX_DETAIL_MAX_TIER_default CTRX_DETAIL_MAX_TIER_DEFAULT
+#define CTRX_DETAIL_MAX_TIER_audit CTRX_DETAIL_MAX_TIER_AUDIT
+#define CTRX_DETAIL_MAX_TIER_axiom CTRX_DETAIL_MAX_TIER_AXIOM
+#define CTRX_DETAIL_MAX_TIER_o_1 CTRX_DETAIL_MAX_TIER_O_1
+#define CTRX_DETAIL_MAX_TIER_o_log_n CTRX_DETAIL_MAX_TIER_O_LOG_N
+#define CTRX_DETAIL_MAX_TIER_o_n CTRX_DETAIL_MAX_TIER_O_N
+#define CTRX_DETAIL_MAX_TIER_o_n_log_n CTRX_DETAIL_MAX_TIER_O_N_LOG_N
+#define CTRX_DETAIL_MAX_TIER_o_n2 CTRX_DETAIL_MAX_TIER_O_N2
 
 // ------------------------------------------------------
 // Default settings
 // ------------------------------------------------------
 
+// CTRX_CONFIG_MAX_COST sets the global level to a cost tier, e.g. O_N
+#if defined(CTRX_CONFIG_MAX_COST)
+#if defined(CTRX_CONFIG_LEVEL)
+#error "ctrx: set either CTRX_CONFIG_LEVEL or CTRX_CONFIG_MAX_COST"
+#endif
+#define CTRX_CONFIG_LEVEL CTRX_CONFIG_MAX_COST
+#endif
+
+// Probing contract checks implies probing violations
+#if defined(CTRX_CONFIG_PROBE_CHECKS) && !defined(CTRX_CONFIG_PROBES)
+#define CTRX_CONFIG_PROBES
+#endif
+
 // If no level is set, use DEFAULT
 #if !defined(CTRX_CONFIG_LEVEL)
 #define CTRX_CONFIG_LEVEL DEFAULT
@@ -93,12 +209,12 @@
 #define CTRX_CONFIG_MODE ASSERT
 #endif
 
-// Fall back to global level, if no specific level is set for ASSERTION/PRECONDITION/POSTCONDITION
+// Fall back to global level, if no specific level is set for ASSERTION/PRECONDITION/POSTCONDITION/INVARIANT
 #if !defined(CTRX_CONFIG_LEVEL_PRECONDITION)
 #define CTRX_CONFIG_LEVEL_PRECONDITION CTRX_CONFIG_LEVEL
 #endif
 
-#if !defined(CTRX_CONFIG_MODE_POSTCONDITION)
+#if !defined(CTRX_CONFIG_LEVEL_POSTCONDITION)
 #define CTRX_CONFIG_LEVEL_POSTCONDITION CTRX_CONFIG_LEVEL
 #endif
 
@@ -106,7 +222,11 @@
 #define CTRX_CONFIG_LEVEL_ASSERTION CTRX_CONFIG_LEVEL
 #endif
 
-// Fall back to global mode, if no specific mode is set for ASSERTION/PRECONDITION/POSTCONDITION
+#if !defined(CTRX_CONFIG_LEVEL_INVARIANT)
+#define CTRX_CONFIG_LEVEL_INVARIANT CTRX_CONFIG_LEVEL
+#endif
+
+// Fall back to global mode, if no specific mode is set for ASSERTION/PRECONDITION/POSTCONDITION/INVARIANT
 #if !defined(CTRX_CONFIG_MODE_PRECONDITION)
 #define CTRX_CONFIG_MODE_PRECONDITION CTRX_CONFIG_MODE
 #endif
@@ -119,6 +239,10 @@
 #define CTRX_CONFIG_MODE_ASSERTION CTRX_CONFIG_MODE
 #endif
 
+#if !defined(CTRX_CONFIG_MODE_INVARIANT)
+#define CTRX_CONFIG_MODE_INVARIANT CTRX_CONFIG_MODE
+#endif
+
 // ------------------------------------------------------
 // Config validation
 // ------------------------------------------------------
@@ -135,6 +259,9 @@
 #if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_ASSERTION) == 0
 #error "Invalid CTRX_CONFIG_LEVEL_ASSERTION"
 #endif
+#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_INVARIANT) == 0
+#error "Invalid CTRX_CONFIG_LEVEL_INVARIANT"
+#endif
 
 #if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE) == 0
 #error "Invalid CTRX_CONFIG_MODE"
@@ -148,6 +275,17 @@
 #if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == 0
 #error "Invalid CTRX_CONFIG_MODE_ASSERTION"
 #endif
+#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == 0
+#error "Invalid CTRX_CONFIG_MODE_INVARIANT"
+#endif
+
+// ------------------------------------------------------
+// Detect exception support
+// ------------------------------------------------------
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define CTRX_DETAIL_HAS_EXCEPTIONS
+#endif
 
 // ------------------------------------------------------
 // Check which modes are in use
@@ -155,34 +293,50 @@
 
 #if (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_PRECONDITION) == CTRX_DETAIL_MODE_NUM_OFF)            \
     || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_POSTCONDITION) == CTRX_DETAIL_MODE_NUM_OFF)        \
-    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_OFF)
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_OFF)            \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == CTRX_DETAIL_MODE_NUM_OFF)
 #define CTRX_DETAIL_USING_MODE_OFF
 #endif
 #if (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_PRECONDITION) == CTRX_DETAIL_MODE_NUM_ASSERT)         \
     || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_POSTCONDITION) == CTRX_DETAIL_MODE_NUM_ASSERT)     \
-    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_ASSERT)
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_ASSERT)         \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == CTRX_DETAIL_MODE_NUM_ASSERT)
 #define CTRX_DETAIL_USING_MODE_ASSERT
 #endif
 #if (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_PRECONDITION) == CTRX_DETAIL_MODE_NUM_ASSUME)         \
     || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_POSTCONDITION) == CTRX_DETAIL_MODE_NUM_ASSUME)     \
-    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_ASSUME)
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_ASSUME)         \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == CTRX_DETAIL_MODE_NUM_ASSUME)
 #define CTRX_DETAIL_USING_MODE_ASSUME
 #endif
 #if (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_PRECONDITION) == CTRX_DETAIL_MODE_NUM_THROW)          \
     || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_POSTCONDITION) == CTRX_DETAIL_MODE_NUM_THROW)      \
-    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_THROW)
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_THROW)          \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == CTRX_DETAIL_MODE_NUM_THROW)
 #define CTRX_DETAIL_USING_MODE_THROW
 #endif
 #if (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_PRECONDITION) == CTRX_DETAIL_MODE_NUM_TERMINATE)      \
     || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_POSTCONDITION) == CTRX_DETAIL_MODE_NUM_TERMINATE)  \
-    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_TERMINATE)
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_TERMINATE)      \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == CTRX_DETAIL_MODE_NUM_TERMINATE)
 #define CTRX_DETAIL_USING_MODE_TERMINATE
 #endif
 #if (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_PRECONDITION) == CTRX_DETAIL_MODE_NUM_HANDLER)        \
     || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_POSTCONDITION) == CTRX_DETAIL_MODE_NUM_HANDLER)    \
-    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_HANDLER)
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_HANDLER)        \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == CTRX_DETAIL_MODE_NUM_HANDLER)
 #define CTRX_DETAIL_USING_MODE_HANDLER
 #endif
+#if (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_PRECONDITION) == CTRX_DETAIL_MODE_NUM_FUZZ)           \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_POSTCONDITION) == CTRX_DETAIL_MODE_NUM_FUZZ)       \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_ASSERTION) == CTRX_DETAIL_MODE_NUM_FUZZ)           \
+    || (CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_CONFIG_MODE_INVARIANT) == CTRX_DETAIL_MODE_NUM_FUZZ)
+#define CTRX_DETAIL_USING_MODE_FUZZ
+#endif
+
+#if defined(CTRX_DETAIL_USING_MODE_THROW) && !defined(CTRX_DETAIL_HAS_EXCEPTIONS)
+#error "ctrx: THROW mode requires exception support; use TERMINATE or HANDLER mode in builds without exceptions"
+#endif
 
 // ------------------------------------------------------
 // Include the required headers
@@ -190,29 +344,103 @@
 
 #if defined(CTRX_DETAIL_USING_MODE_ASSERT)
 #include <concepts>
+#include <exception>
 #include <optional>
+#include <string>
 
 #include <cassert>
 #endif
 #if defined(CTRX_DETAIL_USING_MODE_THROW)
 #include "ctrx/exceptions/assertion_violation.hpp"
 #include "ctrx/exceptions/contract_violation.hpp"
+#include "ctrx/exceptions/invariant_violation.hpp"
 #include "ctrx/exceptions/postcondition_violation.hpp"
 #include "ctrx/exceptions/precondition_violation.hpp"
 
 #include <concepts>
 #include <optional>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <utility>
 #endif
 #if defined(CTRX_DETAIL_USING_MODE_TERMINATE)
+#include "ctrx/crash_record.hpp"
+
 #include <concepts>
 #include <exception>
 #include <optional>
+#include <string>
 #endif
 #if defined(CTRX_DETAIL_USING_MODE_HANDLER)
 #include <concepts>
+#include <exception>
 #include <optional>
 #include <source_location>
+#include <string>
 #include <string_view>
+
+#include <cstdlib>
+#endif
+#if defined(CTRX_DETAIL_USING_MODE_FUZZ)
+#include "ctrx/fuzz.hpp"
+
+#include <concepts>
+#include <exception>
+#include <optional>
+#include <string>
+#endif
+#if defined(CTRX_DETAIL_USING_MODE_ASSERT) || defined(CTRX_DETAIL_USING_MODE_ASSUME)                                   \
+    || defined(CTRX_DETAIL_USING_MODE_THROW) || defined(CTRX_DETAIL_USING_MODE_TERMINATE)                              \
+    || defined(CTRX_DETAIL_USING_MODE_HANDLER) || defined(CTRX_DETAIL_USING_MODE_FUZZ)
+#include "ctrx/cost.hpp"
+#include "ctrx/detail/describe.hpp"
+#include "ctrx/detail/format.hpp"
+#include "ctrx/invariant_guard.hpp"
+#include "ctrx/site_id.hpp"
+#include "ctrx/violation_info.hpp"
+
+#include <source_location>
+#include <string_view>
+#include <type_traits>
+#endif
+#if defined(CTRX_CONFIG_CAPTURE_STACKTRACE)
+#include "ctrx/stacktrace.hpp"
+#endif
+#if defined(CTRX_CONFIG_STRIP_STRINGS)
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/site_id.hpp"
+#endif
+#if defined(CTRX_CONFIG_STRIP_STRINGS) && defined(CTRX_DETAIL_USING_MODE_ASSERT)
+#include "ctrx/crash_record.hpp"
+
+#include <cstdlib>
+#endif
+#if defined(CTRX_CONFIG_PROFILE)
+#include "ctrx/profiler.hpp"
+
+#include <type_traits>
+#endif
+#if defined(CTRX_CONFIG_PROBES)
+#include "ctrx/probes.hpp"
+#endif
+#if defined(CTRX_CONFIG_SITE_OVERRIDES)
+#include "ctrx/site_id.hpp"
+#endif
+#if defined(CTRX_CONFIG_POLICY)
+#include "ctrx/policy.hpp"
+#endif
+#if defined(CTRX_CONFIG_SHARED_COUNTERS)
+#include "ctrx/shared_counters.hpp"
+
+#include <source_location>
+#include <type_traits>
+#endif
+#if defined(CTRX_CONFIG_ADAPTIVE)
+#include "ctrx/adaptive.hpp"
+
+#include <source_location>
+#include <type_traits>
 #endif
 
 // ------------------------------------------------------
@@ -222,10 +450,80 @@
 #if defined(CTRX_DETAIL_USING_MODE_HANDLER)
 namespace ctrx
 {
+#if defined(CTRX_CONFIG_CAPTURE_STACKTRACE)
+extern void
+handle_contract_violation(contract_type, std::string_view, std::source_location const&, raw_stacktrace const&);
+#else
 extern void handle_contract_violation(contract_type, std::string_view, std::source_location const&);
+#endif
 } // namespace ctrx
 #endif
 
+// ------------------------------------------------------
+// Out-of-line reporting
+// ------------------------------------------------------
+
+// Keeps building the exception out of the contract sites, so that they stay small enough to be inlined into loops
+#if defined(CTRX_DETAIL_USING_MODE_THROW)
+namespace ctrx::detail
+{
+#if defined(CTRX_CONFIG_STRIP_STRINGS)
+template<typename Exception, typename... Trace>
+[[noreturn]] CTRX_DETAIL_COLD inline void
+throw_violation(site_id_t site, std::string const& detail, Trace const&... trace)
+{
+    throw Exception{site, detail, trace...};
+}
+#else
+template<typename Exception, typename... Trace>
+[[noreturn]] CTRX_DETAIL_COLD inline void throw_violation(std::string_view            text,
+                                                          std::string const&          detail,
+                                                          std::source_location const& location,
+                                                          Trace const&... trace)
+{
+    std::string message{text};
+    message += detail;
+    throw Exception{std::move(message), location, trace...};
+}
+#endif
+} // namespace ctrx::detail
+#endif
+
+// Keeps formatting the report out of the contract sites if strings are stripped, which only pass their site id
+#if defined(CTRX_CONFIG_STRIP_STRINGS) && defined(CTRX_DETAIL_USING_MODE_HANDLER)
+namespace ctrx::detail
+{
+template<typename... Trace>
+CTRX_DETAIL_COLD inline void
+handle_violation(contract_type type, site_id_t site, std::string const& detail, Trace const&... trace)
+{
+    handle_contract_violation(type, site_message(site) + detail, std::source_location{}, trace...);
+}
+} // namespace ctrx::detail
+#endif
+
+// ------------------------------------------------------
+// Stack trace capture on violations
+// ------------------------------------------------------
+
+#if defined(CTRX_CONFIG_CAPTURE_STACKTRACE)
+#define CTRX_DETAIL_STACKTRACE_ARG , ::ctrx::raw_stacktrace::capture()
+#else
+#define CTRX_DETAIL_STACKTRACE_ARG
+#endif
+
+// ------------------------------------------------------
+// Site ids
+// ------------------------------------------------------
+
+// Compile-time id of a contract site (or of the INDEXth condition of a batch), derived from file, line and the raw text
+#if defined(CTRX_CONFIG_STRIP_STRINGS) || defined(CTRX_DETAIL_USING_MODE_FUZZ) || defined(CTRX_CONFIG_PROBES)          \
+    || defined(CTRX_CONFIG_PROFILE) || defined(CTRX_CONFIG_SITE_OVERRIDES) || defined(CTRX_CONFIG_SHARED_COUNTERS)
+#define CTRX_DETAIL_SITE_ID(RAW, INDEX) ::ctrx::detail::site_id(__FILE__, __LINE__, RAW, INDEX)
+#else
+#define CTRX_DETAIL_SITE_ID(RAW, INDEX) 0
+#endif
+
 // ------------------------------------------------------
 // Map of contract type to exception type
 // ------------------------------------------------------
@@ -233,6 +531,7 @@ extern void handle_contract_violation(contract_type, std::string_view, std::sour
 #define CTRX_DETAIL_EXCEPTION_TYPE_PRECONDITION ::ctrx::precondition_violation
 #define CTRX_DETAIL_EXCEPTION_TYPE_POSTCONDITION ::ctrx::postcondition_violation
 #define CTRX_DETAIL_EXCEPTION_TYPE_ASSERTION ::ctrx::assertion_violation
+#define CTRX_DETAIL_EXCEPTION_TYPE_INVARIANT ::ctrx::invariant_violation
 #define CTRX_DETAIL_EXCEPTION_TYPE(TYPE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_EXCEPTION_TYPE_, TYPE)
 
 // ------------------------------------------------------
@@ -242,13 +541,25 @@ extern void handle_contract_violation(contract_type, std::string_view, std::sour
 #define CTRX_DETAIL_ENUM_TYPE_PRECONDITION ::ctrx::contract_type::precondition
 #define CTRX_DETAIL_ENUM_TYPE_POSTCONDITION ::ctrx::contract_type::postcondition
 #define CTRX_DETAIL_ENUM_TYPE_ASSERTION ::ctrx::contract_type::assertion
+#define CTRX_DETAIL_ENUM_TYPE_INVARIANT ::ctrx::contract_type::invariant
 #define CTRX_DETAIL_ENUM_TYPE(TYPE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_ENUM_TYPE_, TYPE)
 
 // ------------------------------------------------------
 // Implementation of contract checks in all modes
 // ------------------------------------------------------
 
-// Evaluates if a contract check passes (returns an engaged optional with detail message on failure, nullopt on success)
+// Evaluates if a contract check passes (returns an engaged optional with detail message on failure, nullopt on
+// success). Results that can describe themselves, like those of ctrx/predicates.hpp, add their description.
+// Only those are bound to a reference, in a generic lambda that is only instantiated for them, so that other
+// conditions may be bit-fields or packed members.
+#define CTRX_DETAIL_EXPR_DESCRIBED(...)                                                                                \
+    if constexpr (::ctrx::detail::describable<std::remove_cvref_t<decltype((__VA_ARGS__))>>)                           \
+        return ::ctrx::detail::describe_if_failed([&](auto) -> decltype(auto) { return (__VA_ARGS__); });              \
+    else if (__VA_ARGS__)                                                                                              \
+        return std::nullopt;                                                                                           \
+    else                                                                                                               \
+        return std::string()
+#if defined(CTRX_DETAIL_HAS_EXCEPTIONS)
 #define CTRX_DETAIL_EXPR_FAILED(...)                                                                                   \
     [&]() -> std::optional<std::string>                                                                                \
     {                                                                                                                  \
@@ -256,8 +567,7 @@ extern void handle_contract_violation(contract_type, std::string_view, std::sour
                       "contract expression must be convertible to bool");                                              \
         try                                                                                                            \
         {                                                                                                              \
-            if (__VA_ARGS__)                                                                                           \
-                return std::nullopt;                                                                                   \
+            CTRX_DETAIL_EXPR_DESCRIBED(__VA_ARGS__);                                                                   \
         }                                                                                                              \
         catch (std::exception const& e)                                                                                \
         {                                                                                                              \
@@ -267,105 +577,474 @@ extern void handle_contract_violation(contract_type, std::string_view, std::sour
         {                                                                                                              \
             return ": An exception was caught during contract check evaluation";                                       \
         }                                                                                                              \
-        return "";                                                                                                     \
     }()
+#else
+#define CTRX_DETAIL_EXPR_FAILED(...)                                                                                   \
+    [&]() -> std::optional<std::string>                                                                                \
+    {                                                                                                                  \
+        static_assert(std::convertible_to<decltype(__VA_ARGS__), bool>,                                                \
+                      "contract expression must be convertible to bool");                                              \
+        CTRX_DETAIL_EXPR_DESCRIBED(__VA_ARGS__);                                                                       \
+    }()
+#endif
+
+// Evaluates a contract check like CTRX_DETAIL_EXPR_FAILED, counting it in shared memory if shared counters are enabled
+#if defined(CTRX_CONFIG_SHARED_COUNTERS)
+#define CTRX_DETAIL_EXPR_COUNTED(TYPE, LEVEL, SITE, ...)                                                               \
+    [&]() -> std::optional<std::string>                                                                                \
+    {                                                                                                                  \
+        if (std::is_constant_evaluated())                                                                              \
+            return CTRX_DETAIL_EXPR_FAILED(__VA_ARGS__);                                                               \
+        return ::ctrx::detail::count_evaluation<decltype([] {})>(                                                      \
+            CTRX_DETAIL_ENUM_TYPE(TYPE),                                                                               \
+            SITE,                                                                                                      \
+            CTRX_DETAIL_STRINGIFY2(LEVEL),                                                                             \
+            #__VA_ARGS__,                                                                                              \
+            std::source_location::current(),                                                                           \
+            [&] { return CTRX_DETAIL_EXPR_FAILED(__VA_ARGS__); });                                                     \
+    }()
+#else
+#define CTRX_DETAIL_EXPR_COUNTED(TYPE, LEVEL, SITE, ...) CTRX_DETAIL_EXPR_FAILED(__VA_ARGS__)
+#endif
+
+// Evaluates a contract check like CTRX_DETAIL_EXPR_COUNTED, accounting the cost to the site if profiling is enabled
+#if defined(CTRX_CONFIG_PROFILE)
+#define CTRX_DETAIL_EVAL_MEASURED(TYPE, LEVEL, SITE, ...)                                                              \
+    [&]() -> std::optional<std::string>                                                                                \
+    {                                                                                                                  \
+        if (std::is_constant_evaluated())                                                                              \
+            return CTRX_DETAIL_EXPR_COUNTED(TYPE, LEVEL, SITE, __VA_ARGS__);                                           \
+        return ::ctrx::detail::profile_evaluation<decltype([] {})>(                                                    \
+            CTRX_DETAIL_ENUM_TYPE(TYPE),                                                                               \
+            SITE,                                                                                                      \
+            CTRX_DETAIL_STRINGIFY2(LEVEL),                                                                             \
+            #__VA_ARGS__,                                                                                              \
+            std::source_location::current(),                                                                           \
+            [&] { return CTRX_DETAIL_EXPR_COUNTED(TYPE, LEVEL, SITE, __VA_ARGS__); });                                 \
+    }()
+#else
+#define CTRX_DETAIL_EVAL_MEASURED(TYPE, LEVEL, SITE, ...) CTRX_DETAIL_EXPR_COUNTED(TYPE, LEVEL, SITE, __VA_ARGS__)
+#endif
+
+// Samples contract checks above O(1) if adaptive checking is enabled, to keep them within the time budget, unless they
+// have been sampled before
+#if defined(CTRX_CONFIG_ADAPTIVE)
+#define CTRX_DETAIL_EVAL_SAMPLED(TYPE, LEVEL, SITE, ...)                                                               \
+    [&]() -> std::optional<std::string>                                                                                \
+    {                                                                                                                  \
+        if constexpr (CTRX_DETAIL_TIER(LEVEL) <= 1                                                                     \
+                      || ::ctrx::detail::presampled<std::remove_cvref_t<decltype((__VA_ARGS__))>>)                     \
+            return CTRX_DETAIL_EVAL_MEASURED(TYPE, LEVEL, SITE, __VA_ARGS__);                                          \
+        else                                                                                                           \
+        {                                                                                                              \
+            if (std::is_constant_evaluated())                                                                          \
+                return CTRX_DETAIL_EVAL_MEASURED(TYPE, LEVEL, SITE, __VA_ARGS__);                                      \
+            return ::ctrx::detail::adaptive_evaluation<decltype([] {})>(                                               \
+                CTRX_DETAIL_ENUM_TYPE(TYPE),                                                                           \
+                CTRX_DETAIL_STRINGIFY2(LEVEL),                                                                         \
+                #__VA_ARGS__,                                                                                          \
+                std::source_location::current(),                                                                       \
+                [&] { return CTRX_DETAIL_EVAL_MEASURED(TYPE, LEVEL, SITE, __VA_ARGS__); });                            \
+        }                                                                                                              \
+    }()
+#else
+#define CTRX_DETAIL_EVAL_SAMPLED(TYPE, LEVEL, SITE, ...) CTRX_DETAIL_EVAL_MEASURED(TYPE, LEVEL, SITE, __VA_ARGS__)
+#endif
+
+// With a runtime policy, skips contract checks whose file and tier the policy excludes. It is resolved once per site.
+#if defined(CTRX_CONFIG_POLICY)
+#define CTRX_DETAIL_POLICY_ALLOWS(TIER) ::ctrx::detail::policy_allows<decltype([] {})>(__FILE__, TIER)
+#else
+#define CTRX_DETAIL_POLICY_ALLOWS(TIER) true
+#endif
+
+// Skips contract checks whose cost tier exceeds the maximum set at runtime (see ctrx::set_max_cost); for O(1)
+// contracts, that comparison is folded away. With per-site overrides, the tier of the site may have been raised above
+// the configured level, which is a constant and folded away as well.
+#if defined(CTRX_CONFIG_SITE_OVERRIDES)
+#define CTRX_DETAIL_AFFORDABLE(TYPE, LEVEL, SITE)                                                                      \
+    (::ctrx::detail::site_tier(SITE, CTRX_DETAIL_TIER(LEVEL)) <= CTRX_DETAIL_MAX_TIER(TYPE)                            \
+     && ::ctrx::detail::affordable(::ctrx::detail::site_tier(SITE, CTRX_DETAIL_TIER(LEVEL)))                           \
+     && CTRX_DETAIL_POLICY_ALLOWS(::ctrx::detail::site_tier(SITE, CTRX_DETAIL_TIER(LEVEL))))
+#else
+#define CTRX_DETAIL_AFFORDABLE(TYPE, LEVEL, SITE)                                                                      \
+    (::ctrx::detail::affordable(CTRX_DETAIL_TIER(LEVEL)) && CTRX_DETAIL_POLICY_ALLOWS(CTRX_DETAIL_TIER(LEVEL)))
+#endif
+#define CTRX_DETAIL_EVAL_FAILED(TYPE, LEVEL, SITE, ...)                                                                \
+    (CTRX_DETAIL_AFFORDABLE(TYPE, LEVEL, SITE) ? CTRX_DETAIL_EVAL_SAMPLED(TYPE, LEVEL, SITE, __VA_ARGS__)              \
+                                               : std::nullopt)
+
+// Evaluates a contract check like CTRX_DETAIL_EVAL_FAILED, firing the SDT probes of the site if probes are enabled
+#if defined(CTRX_CONFIG_PROBES)
+#define CTRX_DETAIL_PROBE(NAME, TYPE, LEVEL, SITE)                                                                     \
+    ::ctrx::detail::CTRX_DETAIL_CONCAT2(probe_, NAME)<SITE,                                                            \
+                                                      CTRX_DETAIL_ENUM_TYPE(TYPE),                                     \
+                                                      CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, LEVEL)>()
+#if defined(CTRX_CONFIG_PROBE_CHECKS)
+#define CTRX_DETAIL_PROBE_CHECK(TYPE, LEVEL, SITE) CTRX_DETAIL_PROBE(check, TYPE, LEVEL, SITE)
+#else
+#define CTRX_DETAIL_PROBE_CHECK(TYPE, LEVEL, SITE) static_cast<void>(0)
+#endif
+#define CTRX_DETAIL_PROBE_VIOLATION(TYPE, LEVEL, SITE) CTRX_DETAIL_PROBE(violation, TYPE, LEVEL, SITE)
+#define CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, ...)                                                                \
+    [&]() -> std::optional<std::string>                                                                                \
+    {                                                                                                                  \
+        CTRX_DETAIL_PROBE_CHECK(TYPE, LEVEL, SITE);                                                                    \
+        auto ctrx_failure = CTRX_DETAIL_EVAL_FAILED(TYPE, LEVEL, SITE, __VA_ARGS__);                                   \
+        if (ctrx_failure)                                                                                              \
+            CTRX_DETAIL_PROBE_VIOLATION(TYPE, LEVEL, SITE);                                                            \
+        return ctrx_failure;                                                                                           \
+    }()
+#else
+#define CTRX_DETAIL_PROBE_CHECK(TYPE, LEVEL, SITE) static_cast<void>(0)
+#define CTRX_DETAIL_PROBE_VIOLATION(TYPE, LEVEL, SITE) static_cast<void>(0)
+#define CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, ...) CTRX_DETAIL_EVAL_FAILED(TYPE, LEVEL, SITE, __VA_ARGS__)
+#endif
 
-#define CTRX_DETAIL_CHECK_MODE_OFF(TYPE, MSG, ...) CTRX_DETAIL_CHECK_CODE_VALIDITY(__VA_ARGS__)
-#define CTRX_DETAIL_CHECK_MODE_ASSERT(TYPE, MSG, ...) assert(!CTRX_DETAIL_EXPR_FAILED(__VA_ARGS__))
-#define CTRX_DETAIL_CHECK_MODE_ASSUME(TYPE, MSG, ...) [[assume(__VA_ARGS__)]]
-#define CTRX_DETAIL_CHECK_MODE_THROW(TYPE, MSG, ...)                                                                   \
+#define CTRX_DETAIL_CHECK_MODE_OFF(TYPE, LEVEL, SITE, MSG, ...) CTRX_DETAIL_CHECK_CODE_VALIDITY(__VA_ARGS__)
+#define CTRX_DETAIL_CHECK_MODE_ASSUME(TYPE, LEVEL, SITE, MSG, ...) [[assume(__VA_ARGS__)]]
+#if !defined(CTRX_CONFIG_STRIP_STRINGS)
+#define CTRX_DETAIL_CHECK_MODE_ASSERT(TYPE, LEVEL, SITE, MSG, ...)                                                     \
+    assert(!CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__))
+#define CTRX_DETAIL_CHECK_MODE_THROW(TYPE, LEVEL, SITE, MSG, ...)                                                      \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (auto msg = CTRX_DETAIL_EXPR_FAILED(__VA_ARGS__); msg)                                                      \
-            throw CTRX_DETAIL_EXCEPTION_TYPE(TYPE){CTRX_DETAIL_STRINGIFY2(TYPE) " failure: " #__VA_ARGS__ MSG + *msg,  \
-                                                   std::source_location::current()};                                   \
+        if (auto msg = CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__); msg)                                   \
+            ::ctrx::detail::throw_violation<CTRX_DETAIL_EXCEPTION_TYPE(TYPE)>(                                         \
+                CTRX_DETAIL_STRINGIFY2(TYPE) " failure: " #__VA_ARGS__ MSG,                                            \
+                *msg,                                                                                                  \
+                std::source_location::current() CTRX_DETAIL_STACKTRACE_ARG);                                           \
     } while (false)
-#define CTRX_DETAIL_CHECK_MODE_TERMINATE(TYPE, MSG, ...)                                                               \
+#define CTRX_DETAIL_CHECK_MODE_TERMINATE(TYPE, LEVEL, SITE, MSG, ...)                                                  \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (CTRX_DETAIL_EXPR_FAILED(__VA_ARGS__))                                                                      \
+        if (CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__))                                                   \
+        {                                                                                                              \
+            ::ctrx::detail::write_crash_record(CTRX_DETAIL_STRINGIFY2(TYPE),                                           \
+                                               #__VA_ARGS__ MSG,                                                       \
+                                               std::source_location::current());                                       \
             std::terminate();                                                                                          \
+        }                                                                                                              \
     } while (false)
-#define CTRX_DETAIL_CHECK_MODE_HANDLER(TYPE, MSG, ...)                                                                 \
+#define CTRX_DETAIL_CHECK_MODE_HANDLER(TYPE, LEVEL, SITE, MSG, ...)                                                    \
     do                                                                                                                 \
     {                                                                                                                  \
-        auto msg = CTRX_DETAIL_EXPR_FAILED(__VA_ARGS__);                                                               \
+        auto msg = CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__);                                            \
         if (std::is_constant_evaluated() && msg)                                                                       \
             std::abort();                                                                                              \
         else if (msg)                                                                                                  \
             ::ctrx::handle_contract_violation(CTRX_DETAIL_ENUM_TYPE(TYPE),                                             \
                                               #__VA_ARGS__ MSG + *msg,                                                 \
-                                              std::source_location::current());                                        \
+                                              std::source_location::current() CTRX_DETAIL_STACKTRACE_ARG);             \
                                                                                                                        \
     } while (false)
+#else
+// Stripped strings: violations are reported by site id only, so neither the condition text, the message, nor the
+// source location end up in the binary. assert() would stringize the condition, so ASSERT mode reports on its own.
+#if defined(NDEBUG)
+#define CTRX_DETAIL_CHECK_MODE_ASSERT(TYPE, LEVEL, SITE, MSG, ...) CTRX_DETAIL_CHECK_CODE_VALIDITY(__VA_ARGS__)
+#else
+#define CTRX_DETAIL_CHECK_MODE_ASSERT(TYPE, LEVEL, SITE, MSG, ...)                                                     \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__))                                                   \
+        {                                                                                                              \
+            ::ctrx::detail::write_crash_record(CTRX_DETAIL_STRINGIFY2(TYPE), SITE);                                    \
+            std::abort();                                                                                              \
+        }                                                                                                              \
+    } while (false)
+#endif
+#define CTRX_DETAIL_CHECK_MODE_THROW(TYPE, LEVEL, SITE, MSG, ...)                                                      \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (auto msg = CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__); msg)                                   \
+            ::ctrx::detail::throw_violation<CTRX_DETAIL_EXCEPTION_TYPE(TYPE)>(SITE, *msg CTRX_DETAIL_STACKTRACE_ARG);  \
+    } while (false)
+#define CTRX_DETAIL_CHECK_MODE_TERMINATE(TYPE, LEVEL, SITE, MSG, ...)                                                  \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__))                                                   \
+        {                                                                                                              \
+            ::ctrx::detail::write_crash_record(CTRX_DETAIL_STRINGIFY2(TYPE), SITE);                                    \
+            std::terminate();                                                                                          \
+        }                                                                                                              \
+    } while (false)
+#define CTRX_DETAIL_CHECK_MODE_HANDLER(TYPE, LEVEL, SITE, MSG, ...)                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        auto msg = CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__);                                            \
+        if (std::is_constant_evaluated() && msg)                                                                       \
+            std::abort();                                                                                              \
+        else if (msg)                                                                                                  \
+            ::ctrx::detail::handle_violation(CTRX_DETAIL_ENUM_TYPE(TYPE), SITE, *msg CTRX_DETAIL_STACKTRACE_ARG);      \
+    } while (false)
+#endif
+// Fuzzing reports by site id in any case; neither a message is built nor the stack unwound
+#define CTRX_DETAIL_CHECK_MODE_FUZZ(TYPE, LEVEL, SITE, MSG, ...)                                                       \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__)) [[unlikely]]                                      \
+            ::ctrx::detail::fuzz_violation(CTRX_DETAIL_STRINGIFY2(TYPE), SITE);                                        \
+    } while (false)
 
 // ------------------------------------------------------
-// Implementation of contract checks in all levels
+// Implementation of batched contract checks in all modes
 // ------------------------------------------------------
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_PRECONDITION) == CTRX_DETAIL_LEVEL_NUM_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_PRECONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_PRECONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_PRECONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
+// Evaluates all conditions without short-circuiting and combines them with a bitwise and (true if all of them pass)
+#define CTRX_DETAIL_BATCH_AND_ITEM(UNUSED1, UNUSED2, UNUSED3, INDEX, CONDITION)                                        \
+    &static_cast<unsigned>(static_cast<bool>(CONDITION))
+#if defined(CTRX_DETAIL_HAS_EXCEPTIONS)
+#define CTRX_DETAIL_EXPRS_PASSED(...)                                                                                  \
+    [&]() -> bool                                                                                                      \
+    {                                                                                                                  \
+        try                                                                                                            \
+        {                                                                                                              \
+            return (1u CTRX_DETAIL_FOR_EACH(CTRX_DETAIL_BATCH_AND_ITEM, , , , __VA_ARGS__)) != 0u;                     \
+        }                                                                                                              \
+        catch (...)                                                                                                    \
+        {                                                                                                              \
+            return false;                                                                                              \
+        }                                                                                                              \
+    }()
+#else
+#define CTRX_DETAIL_EXPRS_PASSED(...)                                                                                  \
+    ((1u CTRX_DETAIL_FOR_EACH(CTRX_DETAIL_BATCH_AND_ITEM, , , , __VA_ARGS__)) != 0u)
 #endif
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_POSTCONDITION) == CTRX_DETAIL_LEVEL_NUM_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_POSTCONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_POSTCONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_POSTCONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#endif
+// Checks a single condition of a batch with the regular checker, so it is reported with its own text (and site id)
+#define CTRX_DETAIL_BATCH_CHECK_ITEM(CHECKER, TYPE, RAW, INDEX, CONDITION)                                             \
+    CHECKER(TYPE, DEFAULT, CTRX_DETAIL_SITE_ID(RAW, INDEX), CTRX_DETAIL_FORMAT_MSG(), CONDITION);
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_ASSERTION) == CTRX_DETAIL_LEVEL_NUM_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_ASSERTION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_ASSERTION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_ASSERTION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#endif
+// Takes a single branch on the hot path; only if that fails, every condition is checked (and reported) individually
+#define CTRX_DETAIL_CHECK_BATCH(CHECKER, TYPE, RAW, ...)                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!CTRX_DETAIL_EXPRS_PASSED(__VA_ARGS__)) [[unlikely]]                                                       \
+        {                                                                                                              \
+            CTRX_DETAIL_FOR_EACH(CTRX_DETAIL_BATCH_CHECK_ITEM, CHECKER, TYPE, RAW, __VA_ARGS__)                        \
+        }                                                                                                              \
+    } while (false)
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_PRECONDITION) == CTRX_DETAIL_LEVEL_NUM_DEFAULT
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_PRECONDITION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_PRECONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_PRECONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#endif
+// Modes that don't evaluate the conditions (or only do so in debug builds) just check each condition on its own
+#define CTRX_DETAIL_CHECK_EACH(CHECKER, TYPE, RAW, ...)                                                                \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        CTRX_DETAIL_FOR_EACH(CTRX_DETAIL_BATCH_CHECK_ITEM, CHECKER, TYPE, RAW, __VA_ARGS__)                            \
+    } while (false)
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_POSTCONDITION) == CTRX_DETAIL_LEVEL_NUM_DEFAULT
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_POSTCONDITION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_POSTCONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_POSTCONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
+// The batch checkers receive the stringized conditions instead of a site id, to derive one site id per condition
+#define CTRX_DETAIL_CHECK_BATCH_MODE_OFF(TYPE, LEVEL, RAW, MSG, ...)                                                   \
+    CTRX_DETAIL_CHECK_MODE_OFF(TYPE, LEVEL, RAW, MSG, __VA_ARGS__)
+#define CTRX_DETAIL_CHECK_BATCH_MODE_ASSERT(TYPE, LEVEL, RAW, MSG, ...)                                                \
+    CTRX_DETAIL_CHECK_EACH(CTRX_DETAIL_CHECK_MODE_ASSERT, TYPE, RAW, __VA_ARGS__)
+#define CTRX_DETAIL_CHECK_BATCH_MODE_ASSUME(TYPE, LEVEL, RAW, MSG, ...)                                                \
+    CTRX_DETAIL_CHECK_EACH(CTRX_DETAIL_CHECK_MODE_ASSUME, TYPE, RAW, __VA_ARGS__)
+// When profiling or probing checks, conditions are evaluated individually so the cost of each of them is known, or
+// each of them fires its probe. With per-site overrides or a runtime policy, each of them may be checked or not.
+#if defined(CTRX_CONFIG_PROFILE) || defined(CTRX_CONFIG_PROBE_CHECKS) || defined(CTRX_CONFIG_SITE_OVERRIDES)           \
+    || defined(CTRX_CONFIG_POLICY) || defined(CTRX_CONFIG_SHARED_COUNTERS)
+#define CTRX_DETAIL_CHECK_BATCH_OR_EACH CTRX_DETAIL_CHECK_EACH
+#else
+#define CTRX_DETAIL_CHECK_BATCH_OR_EACH CTRX_DETAIL_CHECK_BATCH
 #endif
+#define CTRX_DETAIL_CHECK_BATCH_MODE_THROW(TYPE, LEVEL, RAW, MSG, ...)                                                 \
+    CTRX_DETAIL_CHECK_BATCH_OR_EACH(CTRX_DETAIL_CHECK_MODE_THROW, TYPE, RAW, __VA_ARGS__)
+#define CTRX_DETAIL_CHECK_BATCH_MODE_TERMINATE(TYPE, LEVEL, RAW, MSG, ...)                                             \
+    CTRX_DETAIL_CHECK_BATCH_OR_EACH(CTRX_DETAIL_CHECK_MODE_TERMINATE, TYPE, RAW, __VA_ARGS__)
+#define CTRX_DETAIL_CHECK_BATCH_MODE_HANDLER(TYPE, LEVEL, RAW, MSG, ...)                                               \
+    CTRX_DETAIL_CHECK_BATCH_OR_EACH(CTRX_DETAIL_CHECK_MODE_HANDLER, TYPE, RAW, __VA_ARGS__)
+#define CTRX_DETAIL_CHECK_BATCH_MODE_FUZZ(TYPE, LEVEL, RAW, MSG, ...)                                                  \
+    CTRX_DETAIL_CHECK_BATCH_OR_EACH(CTRX_DETAIL_CHECK_MODE_FUZZ, TYPE, RAW, __VA_ARGS__)
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_ASSERTION) == CTRX_DETAIL_LEVEL_NUM_DEFAULT
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_ASSERTION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_ASSERTION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_ASSERTION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
+// ------------------------------------------------------
+// Implementation of invariant guards
+// ------------------------------------------------------
+
+// Strip the parentheses of a parenthesized argument list, and invoke a macro with such a list
+#define CTRX_DETAIL_UNPAREN(...) __VA_ARGS__
+#define CTRX_DETAIL_APPLY(MACRO, ARGS) MACRO ARGS
+
+// Declares a guard that runs the regular checker of TYPE on scope entry (if ON_ENTRY) and exit. GUARD is the
+// parenthesized (ON_ENTRY, PERIOD, SITE), so that disabled guards are replaced by CTRX_DETAIL_CHECK_MODE_OFF.
+#define CTRX_DETAIL_CHECK_GUARD(TYPE, LEVEL, GUARD, MSG, ...)                                                          \
+    CTRX_DETAIL_APPLY(CTRX_DETAIL_CHECK_GUARD_IMPL, (TYPE, LEVEL, CTRX_DETAIL_UNPAREN GUARD, MSG, __VA_ARGS__))
+#define CTRX_DETAIL_CHECK_GUARD_IMPL(TYPE, LEVEL, ON_ENTRY, PERIOD, SITE, MSG, ...)                                    \
+    ::ctrx::detail::invariant_guard CTRX_DETAIL_CONCAT2(ctrx_invariant_guard_, __LINE__)                               \
+    {                                                                                                                  \
+        [&] { CTRX_DETAIL_GET_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(TYPE))(TYPE, LEVEL, SITE, MSG, __VA_ARGS__); },   \
+        ON_ENTRY,                                                                                                      \
+        ::ctrx::detail::sample_invariant<decltype([] {})>(PERIOD)                                                      \
+    }
+
+// Invariants in OFF mode don't need a guard
+#define CTRX_DETAIL_CHECK_GUARD_MODE_OFF CTRX_DETAIL_CHECK_MODE_OFF
+#define CTRX_DETAIL_CHECK_GUARD_MODE_ASSERT CTRX_DETAIL_CHECK_GUARD
+#define CTRX_DETAIL_CHECK_GUARD_MODE_ASSUME CTRX_DETAIL_CHECK_GUARD
+#define CTRX_DETAIL_CHECK_GUARD_MODE_THROW CTRX_DETAIL_CHECK_GUARD
+#define CTRX_DETAIL_CHECK_GUARD_MODE_TERMINATE CTRX_DETAIL_CHECK_GUARD
+#define CTRX_DETAIL_CHECK_GUARD_MODE_HANDLER CTRX_DETAIL_CHECK_GUARD
+#define CTRX_DETAIL_CHECK_GUARD_MODE_FUZZ CTRX_DETAIL_CHECK_GUARD
+
+// ------------------------------------------------------
+// Implementation of error-return contract checks
+// ------------------------------------------------------
+
+// Returns VALUE from the enclosing function if the condition fails, instead of handling the violation as the mode
+// would. GUARD is the parenthesized (SITE, VALUE), so that disabled checks are replaced by CTRX_DETAIL_CHECK_MODE_OFF.
+// VALUE may refer to the violation_info ctrx_violation. MSG is the plain message literal.
+#define CTRX_DETAIL_CHECK_RETURN(TYPE, LEVEL, GUARD, MSG, ...)                                                         \
+    CTRX_DETAIL_APPLY(CTRX_DETAIL_CHECK_RETURN_IMPL, (TYPE, LEVEL, CTRX_DETAIL_UNPAREN GUARD, MSG, __VA_ARGS__))
+#define CTRX_DETAIL_CHECK_RETURN_IMPL(TYPE, LEVEL, SITE, VALUE, MSG, ...)                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (CTRX_DETAIL_EVAL_PROBED(TYPE, LEVEL, SITE, __VA_ARGS__)) [[unlikely]]                                      \
+        {                                                                                                              \
+            [[maybe_unused]] ::ctrx::violation_info const ctrx_violation{                                              \
+                CTRX_DETAIL_ENUM_TYPE(TYPE),                                                                           \
+                SITE,                                                                                                  \
+                CTRX_DETAIL_VIOLATION_TEXT(#__VA_ARGS__, MSG)};                                                        \
+            return VALUE;                                                                                              \
+        }                                                                                                              \
+    } while (false)
+#if defined(CTRX_CONFIG_STRIP_STRINGS)
+#define CTRX_DETAIL_VIOLATION_TEXT(CONDITION, MSG) std::string_view{}, std::string_view{}, std::source_location{}
+#else
+#define CTRX_DETAIL_VIOLATION_TEXT(CONDITION, MSG) CONDITION, MSG, std::source_location::current()
 #endif
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_PRECONDITION) == CTRX_DETAIL_LEVEL_NUM_AUDIT
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_PRECONDITION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_PRECONDITION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_PRECONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
+// Error-return contracts are checked in every mode but OFF. ASSUME mode checks them as well: their failure is an
+// expected error path, and assuming it away would turn that error into undefined behavior.
+#define CTRX_DETAIL_CHECK_RETURN_MODE_OFF CTRX_DETAIL_CHECK_MODE_OFF
+#define CTRX_DETAIL_CHECK_RETURN_MODE_ASSERT CTRX_DETAIL_CHECK_RETURN
+#define CTRX_DETAIL_CHECK_RETURN_MODE_ASSUME CTRX_DETAIL_CHECK_RETURN
+#define CTRX_DETAIL_CHECK_RETURN_MODE_THROW CTRX_DETAIL_CHECK_RETURN
+#define CTRX_DETAIL_CHECK_RETURN_MODE_TERMINATE CTRX_DETAIL_CHECK_RETURN
+#define CTRX_DETAIL_CHECK_RETURN_MODE_HANDLER CTRX_DETAIL_CHECK_RETURN
+#define CTRX_DETAIL_CHECK_RETURN_MODE_FUZZ CTRX_DETAIL_CHECK_RETURN
+
+// ------------------------------------------------------
+// Implementation of contract checks in all levels
+// ------------------------------------------------------
+
+// Per contract type and cost tier, contracts are either checked with CHECKER, or not at all
+#define CTRX_DETAIL_MAX_TIER(TYPE)                                                                                     \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MAX_TIER_, CTRX_DETAIL_CONCAT2(CTRX_CONFIG_LEVEL_, TYPE))
+#define CTRX_DETAIL_CHECK_TIER_ON(CHECKER) CHECKER
+#define CTRX_DETAIL_CHECK_TIER_OFF(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
+
+#if CTRX_DETAIL_MAX_TIER(PRECONDITION) >= 1
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(PRECONDITION) >= 2
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_OFF
 #endif
+#if CTRX_DETAIL_MAX_TIER(PRECONDITION) >= 3
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(PRECONDITION) >= 4
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(PRECONDITION) >= 5
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#define CTRX_DETAIL_CHECK_TIER_6_TYPE_PRECONDITION CTRX_DETAIL_CHECK_TIER_OFF
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_POSTCONDITION) == CTRX_DETAIL_LEVEL_NUM_AUDIT
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_POSTCONDITION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_POSTCONDITION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_POSTCONDITION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
+#if CTRX_DETAIL_MAX_TIER(POSTCONDITION) >= 1
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(POSTCONDITION) >= 2
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(POSTCONDITION) >= 3
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(POSTCONDITION) >= 4
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(POSTCONDITION) >= 5
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_OFF
 #endif
+#define CTRX_DETAIL_CHECK_TIER_6_TYPE_POSTCONDITION CTRX_DETAIL_CHECK_TIER_OFF
 
-#if CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_CONFIG_LEVEL_ASSERTION) == CTRX_DETAIL_LEVEL_NUM_AUDIT
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_ASSERTION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_ASSERTION(CHECKER) CHECKER
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_ASSERTION(CHECKER) CTRX_DETAIL_CHECK_MODE_OFF
+#if CTRX_DETAIL_MAX_TIER(ASSERTION) >= 1
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_OFF
 #endif
+#if CTRX_DETAIL_MAX_TIER(ASSERTION) >= 2
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(ASSERTION) >= 3
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(ASSERTION) >= 4
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(ASSERTION) >= 5
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#define CTRX_DETAIL_CHECK_TIER_6_TYPE_ASSERTION CTRX_DETAIL_CHECK_TIER_OFF
 
-#define CTRX_DETAIL_CHECK_LEVEL_DEFAULT(CHECKER, TYPE)                                                                 \
-    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_LEVEL_DEFAULT_TYPE_, TYPE)(CHECKER)
-#define CTRX_DETAIL_CHECK_LEVEL_AUDIT(CHECKER, TYPE)                                                                   \
-    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_LEVEL_AUDIT_TYPE_, TYPE)(CHECKER)
-#define CTRX_DETAIL_CHECK_LEVEL_AXIOM(CHECKER, TYPE)                                                                   \
-    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_LEVEL_AXIOM_TYPE_, TYPE)(CHECKER)
+#if CTRX_DETAIL_MAX_TIER(INVARIANT) >= 1
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_1_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(INVARIANT) >= 2
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_2_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(INVARIANT) >= 3
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_3_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(INVARIANT) >= 4
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_4_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#if CTRX_DETAIL_MAX_TIER(INVARIANT) >= 5
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_ON
+#else
+#define CTRX_DETAIL_CHECK_TIER_5_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_OFF
+#endif
+#define CTRX_DETAIL_CHECK_TIER_6_TYPE_INVARIANT CTRX_DETAIL_CHECK_TIER_OFF
 
+// Selects CHECKER or CTRX_DETAIL_CHECK_MODE_OFF by the tier of the (canonical) contract level
+#define CTRX_DETAIL_TIER(LEVEL) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_TIER_, LEVEL)
 #define CTRX_DETAIL_CHECK_LEVEL(CHECKER, TYPE, LEVEL)                                                                  \
-    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_LEVEL_, LEVEL)(CHECKER, TYPE)
+    CTRX_DETAIL_CONCAT4(CTRX_DETAIL_CHECK_TIER_, CTRX_DETAIL_TIER(LEVEL), _TYPE_, TYPE)(CHECKER)
 
 // ------------------------------------------------------
 // Map of types to canonical types (i.e. lowercase to uppercase)
@@ -374,9 +1053,11 @@ extern void handle_contract_violation(contract_type, std::string_view, std::sour
 #define CTRX_DETAIL_TYPE_PRECONDITION PRECONDITION
 #define CTRX_DETAIL_TYPE_POSTCONDITION POSTCONDITION
 #define CTRX_DETAIL_TYPE_ASSERTION ASSERTION
+#define CTRX_DETAIL_TYPE_INVARIANT INVARIANT
 #define CTRX_DETAIL_TYPE_precondition CTRX_DETAIL_TYPE_PRECONDITION
 #define CTRX_DETAIL_TYPE_postcondition CTRX_DETAIL_TYPE_POSTCONDITION
 #define CTRX_DETAIL_TYPE_assertion CTRX_DETAIL_TYPE_ASSERTION
+#define CTRX_DETAIL_TYPE_invariant CTRX_DETAIL_TYPE_INVARIANT
 #define CTRX_DETAIL_TYPE(TYPE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_TYPE_, TYPE)
 
 // ------------------------------------------------------
@@ -389,32 +1070,206 @@ extern void handle_contract_violation(contract_type, std::string_view, std::sour
 #define CTRX_DETAIL_LEVEL_default CTRX_DETAIL_LEVEL_DEFAULT
 #define CTRX_DETAIL_LEVEL_audit CTRX_DETAIL_LEVEL_AUDIT
 #define CTRX_DETAIL_LEVEL_axiom CTRX_DETAIL_LEVEL_AXIOM
+#define CTRX_DETAIL_LEVEL_O_1 O_1
+#define CTRX_DETAIL_LEVEL_O_LOG_N O_LOG_N
+#define CTRX_DETAIL_LEVEL_O_N O_N
+#define CTRX_DETAIL_LEVEL_O_N_LOG_N O_N_LOG_N
+#define CTRX_DETAIL_LEVEL_O_N2 O_N2
+#define CTRX_DETAIL_LEVEL_o_1 CTRX_DETAIL_LEVEL_O_1
+#define CTRX_DETAIL_LEVEL_o_log_n CTRX_DETAIL_LEVEL_O_LOG_N
+#define CTRX_DETAIL_LEVEL_o_n CTRX_DETAIL_LEVEL_O_N
+#define CTRX_DETAIL_LEVEL_o_n_log_n CTRX_DETAIL_LEVEL_O_N_LOG_N
+#define CTRX_DETAIL_LEVEL_o_n2 CTRX_DETAIL_LEVEL_O_N2
 #define CTRX_DETAIL_LEVEL(LEVEL) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_, LEVEL)
 
+// ------------------------------------------------------
+// Per-site level overrides
+// ------------------------------------------------------
+
+// CTRX_CONFIG_SITE_OVERRIDES names a header of CTRX_SITE_OVERRIDE(site id, level) lines, as generated by ctrx-tier.
+// The contract at each of those sites is checked as if it had the given level. As the configured level selects the
+// checker before the site is known, overrides can only demote contracts, not enable ones the level turns off.
+#if defined(CTRX_CONFIG_SITE_OVERRIDES)
+namespace ctrx::detail
+{
+struct site_override
+{
+    site_id_t site;
+    int       tier;
+};
+
+#define CTRX_SITE_OVERRIDE(SITE, LEVEL) site_override{SITE, CTRX_DETAIL_TIER(CTRX_DETAIL_LEVEL(LEVEL))},
+inline constexpr site_override site_overrides[] = {
+#include CTRX_CONFIG_SITE_OVERRIDES
+    site_override{0, 0},
+};
+#undef CTRX_SITE_OVERRIDE
+
+// Cost tier of the contract at site, whose level has the given tier
+[[nodiscard]] consteval auto site_tier(site_id_t site, int tier) noexcept -> int
+{
+    for (auto const& o : site_overrides)
+        if (o.tier != 0 && o.site == site)
+            return o.tier > tier ? o.tier : tier;
+    return tier;
+}
+} // namespace ctrx::detail
+#endif
+
 // ------------------------------------------------------
 // Implementation of the main macros
 // ------------------------------------------------------
 
 #define CTRX_DETAIL_GET_MODE_FROM_TYPE(TYPE) CTRX_DETAIL_CONCAT2(CTRX_CONFIG_MODE_, TYPE)
 #define CTRX_DETAIL_GET_CHECKER(MODE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_MODE_, MODE)
+#define CTRX_DETAIL_GET_BATCH_CHECKER(MODE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_BATCH_MODE_, MODE)
+#define CTRX_DETAIL_GET_GUARD_CHECKER(MODE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_GUARD_MODE_, MODE)
+#define CTRX_DETAIL_GET_RETURN_CHECKER(MODE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_RETURN_MODE_, MODE)
 #define CTRX_DETAIL_FORMAT_MSG(...) "" __VA_OPT__(" (" __VA_ARGS__ ")")
+// A formatted message is a std::string that is appended to the condition text. It is only built on failure, when the
+// checkers concatenate their message; the arguments are referenced where they are, and not copied.
+#define CTRX_DETAIL_FORMAT_MSG_ARGS(FORMAT, ...) + ::ctrx::detail::format_message(FORMAT, __VA_ARGS__)
+// Modes that don't report messages still use the format arguments, in an unevaluated context
+#define CTRX_DETAIL_FORMAT_ARG(UNUSED1, UNUSED2, UNUSED3, INDEX, ARG) (void)(ARG),
+#define CTRX_DETAIL_CHECK_FORMAT_VALIDITY(...)                                                                         \
+    CTRX_DETAIL_CHECK_CODE_VALIDITY(CTRX_DETAIL_FOR_EACH(CTRX_DETAIL_FORMAT_ARG, , , , __VA_ARGS__) 0)
 
-#define CTRX_DETAIL_CONTRACT_4(TYPE, CONDITION, LEVEL, MESSAGE)                                                        \
+#define CTRX_DETAIL_CONTRACT_MSG(SITE, TYPE, CONDITION, LEVEL, MSG)                                                    \
     CTRX_DETAIL_CHECK_LEVEL(CTRX_DETAIL_GET_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(CTRX_DETAIL_TYPE(TYPE))),           \
                             CTRX_DETAIL_TYPE(TYPE),                                                                    \
                             CTRX_DETAIL_LEVEL(LEVEL))                                                                  \
-    (CTRX_DETAIL_TYPE(TYPE), CTRX_DETAIL_FORMAT_MSG(MESSAGE), CONDITION)
-#define CTRX_DETAIL_CONTRACT_3(TYPE, CONDITION, LEVEL) CTRX_DETAIL_CONTRACT_4(TYPE, CONDITION, LEVEL, )
-#define CTRX_DETAIL_CONTRACT_2(TYPE, CONDITION) CTRX_DETAIL_CONTRACT_3(TYPE, CONDITION, DEFAULT)
-#define CTRX_CONTRACT(TYPE, ...)                                                                                       \
-    CTRX_DETAIL_GET_OVERLOADED_MACRO_3(__VA_ARGS__,                                                                    \
-                                       CTRX_DETAIL_CONTRACT_4,                                                         \
-                                       CTRX_DETAIL_CONTRACT_3,                                                         \
-                                       CTRX_DETAIL_CONTRACT_2)                                                         \
-    (TYPE, __VA_ARGS__)
-
-#define CTRX_PRECONDITION(...) CTRX_CONTRACT(PRECONDITION, __VA_ARGS__)
-#define CTRX_POSTCONDITION(...) CTRX_CONTRACT(POSTCONDITION, __VA_ARGS__)
-#define CTRX_ASSERT(...) CTRX_CONTRACT(ASSERTION, __VA_ARGS__)
+    (CTRX_DETAIL_TYPE(TYPE), CTRX_DETAIL_LEVEL(LEVEL), SITE, MSG, CONDITION)
+#define CTRX_DETAIL_CONTRACT_FMT(SITE, TYPE, CONDITION, LEVEL, FORMAT, ...)                                            \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        CTRX_DETAIL_CHECK_FORMAT_VALIDITY(__VA_ARGS__);                                                                \
+        CTRX_DETAIL_CONTRACT_MSG(SITE, TYPE, CONDITION, LEVEL, CTRX_DETAIL_FORMAT_MSG_ARGS(FORMAT, __VA_ARGS__));      \
+    } while (false)
+#define CTRX_DETAIL_CONTRACT_4(SITE, TYPE, CONDITION, LEVEL, MESSAGE)                                                  \
+    CTRX_DETAIL_CONTRACT_MSG(SITE, TYPE, CONDITION, LEVEL, CTRX_DETAIL_FORMAT_MSG(MESSAGE))
+#define CTRX_DETAIL_CONTRACT_3(SITE, TYPE, CONDITION, LEVEL) CTRX_DETAIL_CONTRACT_4(SITE, TYPE, CONDITION, LEVEL, )
+#define CTRX_DETAIL_CONTRACT_2(SITE, TYPE, CONDITION) CTRX_DETAIL_CONTRACT_3(SITE, TYPE, CONDITION, DEFAULT)
+#define CTRX_DETAIL_CONTRACT(SITE, TYPE, ...)                                                                          \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CONTRACT_, CTRX_DETAIL_OVERLOAD(__VA_ARGS__))(SITE, TYPE, __VA_ARGS__)
+
+// The public macros stringize their arguments themselves, before any macros within them are expanded
+#define CTRX_CONTRACT(TYPE, ...) CTRX_DETAIL_CONTRACT(CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0), TYPE, __VA_ARGS__)
+
+#define CTRX_PRECONDITION(...) CTRX_DETAIL_CONTRACT(CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0), PRECONDITION, __VA_ARGS__)
+#define CTRX_POSTCONDITION(...) CTRX_DETAIL_CONTRACT(CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0), POSTCONDITION, __VA_ARGS__)
+#define CTRX_ASSERT(...) CTRX_DETAIL_CONTRACT(CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0), ASSERTION, __VA_ARGS__)
+
+#define CTRX_DETAIL_CONTRACTS(RAW, TYPE, ...)                                                                          \
+    CTRX_DETAIL_CHECK_LEVEL(CTRX_DETAIL_GET_BATCH_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(CTRX_DETAIL_TYPE(TYPE))),     \
+                            CTRX_DETAIL_TYPE(TYPE),                                                                    \
+                            DEFAULT)                                                                                   \
+    (CTRX_DETAIL_TYPE(TYPE), DEFAULT, RAW, CTRX_DETAIL_FORMAT_MSG(), __VA_ARGS__)
+#define CTRX_CONTRACTS(TYPE, ...) CTRX_DETAIL_CONTRACTS(#__VA_ARGS__, TYPE, __VA_ARGS__)
+
+#define CTRX_PRECONDITIONS(...) CTRX_DETAIL_CONTRACTS(#__VA_ARGS__, PRECONDITION, __VA_ARGS__)
+#define CTRX_POSTCONDITIONS(...) CTRX_DETAIL_CONTRACTS(#__VA_ARGS__, POSTCONDITION, __VA_ARGS__)
+#define CTRX_ASSERTS(...) CTRX_DETAIL_CONTRACTS(#__VA_ARGS__, ASSERTION, __VA_ARGS__)
+
+#define CTRX_DETAIL_OR_RETURN_4(SITE, VALUE, CONDITION, LEVEL, MESSAGE)                                                \
+    CTRX_DETAIL_CHECK_LEVEL(CTRX_DETAIL_GET_RETURN_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(PRECONDITION)),              \
+                            PRECONDITION,                                                                              \
+                            CTRX_DETAIL_LEVEL(LEVEL))                                                                  \
+    (PRECONDITION, CTRX_DETAIL_LEVEL(LEVEL), (SITE, VALUE), MESSAGE, CONDITION)
+#define CTRX_DETAIL_OR_RETURN_3(SITE, VALUE, CONDITION, LEVEL)                                                         \
+    CTRX_DETAIL_OR_RETURN_4(SITE, VALUE, CONDITION, LEVEL, "")
+#define CTRX_DETAIL_OR_RETURN_2(SITE, VALUE, CONDITION) CTRX_DETAIL_OR_RETURN_3(SITE, VALUE, CONDITION, DEFAULT)
+// The violation_info doesn't own its strings, so that it's built without allocating; a formatted message would be
+// destroyed while the returned value still refers to it
+#define CTRX_DETAIL_OR_RETURN_FMT(SITE, VALUE, CONDITION, LEVEL, FORMAT, ...)                                          \
+    static_assert(false,                                                                                               \
+                  "CTRX_PRECONDITION_OR_RETURN and CTRX_PRECONDITION_OR_UNEXPECTED take a message literal, not a "     \
+                  "formatted message")
+#define CTRX_DETAIL_OR_RETURN(SITE, VALUE, ...)                                                                        \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_OR_RETURN_, CTRX_DETAIL_OVERLOAD(__VA_ARGS__))(SITE, VALUE, __VA_ARGS__)
+
+// Return VALUE, or an std::unexpected<ctrx::violation_info>, from the enclosing function if the precondition fails. The
+// site id is always computed, as it is part of the violation_info.
+#define CTRX_PRECONDITION_OR_RETURN(VALUE, ...)                                                                        \
+    CTRX_DETAIL_OR_RETURN(::ctrx::detail::site_id(__FILE__, __LINE__, #__VA_ARGS__, 0), VALUE, __VA_ARGS__)
+#define CTRX_PRECONDITION_OR_UNEXPECTED(...)                                                                           \
+    CTRX_DETAIL_OR_RETURN(::ctrx::detail::site_id(__FILE__, __LINE__, #__VA_ARGS__, 0),                                \
+                          std::unexpected(ctrx_violation),                                                             \
+                          __VA_ARGS__)
+
+#define CTRX_DETAIL_INVARIANT_GUARD_MSG(GUARD, CONDITION, LEVEL, MSG)                                                  \
+    CTRX_DETAIL_CHECK_LEVEL(CTRX_DETAIL_GET_GUARD_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(INVARIANT)),                  \
+                            INVARIANT,                                                                                 \
+                            CTRX_DETAIL_LEVEL(LEVEL))                                                                  \
+    (INVARIANT, CTRX_DETAIL_LEVEL(LEVEL), GUARD, MSG, CONDITION)
+#define CTRX_DETAIL_INVARIANT_GUARD_FMT(GUARD, CONDITION, LEVEL, FORMAT, ...)                                          \
+    CTRX_DETAIL_CHECK_FORMAT_VALIDITY(__VA_ARGS__);                                                                    \
+    CTRX_DETAIL_INVARIANT_GUARD_MSG(GUARD, CONDITION, LEVEL, CTRX_DETAIL_FORMAT_MSG_ARGS(FORMAT, __VA_ARGS__))
+#define CTRX_DETAIL_INVARIANT_GUARD_4(GUARD, CONDITION, LEVEL, MESSAGE)                                                \
+    CTRX_DETAIL_INVARIANT_GUARD_MSG(GUARD, CONDITION, LEVEL, CTRX_DETAIL_FORMAT_MSG(MESSAGE))
+#define CTRX_DETAIL_INVARIANT_GUARD_3(GUARD, CONDITION, LEVEL)                                                         \
+    CTRX_DETAIL_INVARIANT_GUARD_4(GUARD, CONDITION, LEVEL, )
+#define CTRX_DETAIL_INVARIANT_GUARD_2(GUARD, CONDITION) CTRX_DETAIL_INVARIANT_GUARD_3(GUARD, CONDITION, DEFAULT)
+#define CTRX_DETAIL_INVARIANT_GUARD(GUARD, ...)                                                                        \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_INVARIANT_GUARD_, CTRX_DETAIL_OVERLOAD(__VA_ARGS__))(GUARD, __VA_ARGS__)
+
+#define CTRX_INVARIANT(...) CTRX_DETAIL_CONTRACT(CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0), INVARIANT, __VA_ARGS__)
+#define CTRX_INVARIANTS(...) CTRX_DETAIL_CONTRACTS(#__VA_ARGS__, INVARIANT, __VA_ARGS__)
+
+// Checks the invariant on entry and on every (non-exceptional) exit of the enclosing scope
+#define CTRX_INVARIANT_GUARD(...)                                                                                      \
+    CTRX_DETAIL_INVARIANT_GUARD((true, 1u, CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0)), __VA_ARGS__)
+// Checks the invariant on every (non-exceptional) exit of the enclosing scope only, e.g. in constructors
+#define CTRX_INVARIANT_GUARD_ON_EXIT(...)                                                                              \
+    CTRX_DETAIL_INVARIANT_GUARD((false, 1u, CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0)), __VA_ARGS__)
+// Like CTRX_INVARIANT_GUARD, but only on the first and then every PERIOD-th time per thread the scope is entered
+#define CTRX_INVARIANT_GUARD_SAMPLED(PERIOD, ...)                                                                      \
+    CTRX_DETAIL_INVARIANT_GUARD((true, PERIOD, CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0)), __VA_ARGS__)
+
+// ------------------------------------------------------
+// ODR safety
+// ------------------------------------------------------
+
+#define CTRX_DETAIL_CONCAT4(A, B, C, D) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CONCAT2(A, B), CTRX_DETAIL_CONCAT2(C, D))
+#define CTRX_DETAIL_MODE_NUM(TYPE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_MODE_NUM_, CTRX_DETAIL_GET_MODE_FROM_TYPE(TYPE))
+#define CTRX_DETAIL_LEVEL_NUM(TYPE)                                                                                    \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_LEVEL_NUM_, CTRX_DETAIL_CONCAT2(CTRX_CONFIG_LEVEL_, TYPE))
+
+// Modes as they are keyed in the ABI namespace. ASSERT mode only evaluates contracts without NDEBUG (like assert()),
+// so ASSERT with NDEBUG gets a key of its own (8): debug and release builds mustn't share definitions or ghost layouts.
+#define CTRX_DETAIL_ABI_MODE_NUM(TYPE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_ABI_MODE_NUM_, CTRX_DETAIL_MODE_NUM(TYPE))
+#define CTRX_DETAIL_ABI_MODE_NUM_1 1
+#if defined(NDEBUG)
+#define CTRX_DETAIL_ABI_MODE_NUM_2 8
+#else
+#define CTRX_DETAIL_ABI_MODE_NUM_2 2
+#endif
+#define CTRX_DETAIL_ABI_MODE_NUM_3 3
+#define CTRX_DETAIL_ABI_MODE_NUM_4 4
+#define CTRX_DETAIL_ABI_MODE_NUM_5 5
+#define CTRX_DETAIL_ABI_MODE_NUM_6 6
+#define CTRX_DETAIL_ABI_MODE_NUM_7 7
+
+// Name of an inline namespace that is unique to the mode and level of every contract type, e.g. ctrx_4444_2222.
+// Inline functions that check contracts and are shared between differently configured libraries should be defined
+// within it (or be tagged with CTRX_ABI), so that each configuration gets its own definition and symbol.
+#define CTRX_ABI_NAMESPACE                                                                                             \
+    CTRX_DETAIL_CONCAT4(ctrx_,                                                                                         \
+                        CTRX_DETAIL_CONCAT4(CTRX_DETAIL_ABI_MODE_NUM(PRECONDITION),                                    \
+                                            CTRX_DETAIL_ABI_MODE_NUM(POSTCONDITION),                                   \
+                                            CTRX_DETAIL_ABI_MODE_NUM(ASSERTION),                                       \
+                                            CTRX_DETAIL_ABI_MODE_NUM(INVARIANT)),                                      \
+                        _,                                                                                             \
+                        CTRX_DETAIL_CONCAT4(CTRX_DETAIL_LEVEL_NUM(PRECONDITION),                                       \
+                                            CTRX_DETAIL_LEVEL_NUM(POSTCONDITION),                                      \
+                                            CTRX_DETAIL_LEVEL_NUM(ASSERTION),                                          \
+                                            CTRX_DETAIL_LEVEL_NUM(INVARIANT)))
+
+// Tags a function with the configuration, which becomes part of its mangled name. Has no effect on compilers without
+// ABI tags (e.g. MSVC); use CTRX_ABI_NAMESPACE there.
+#if defined(__GNUC__)
+#define CTRX_ABI [[gnu::abi_tag(CTRX_DETAIL_STRINGIFY2(CTRX_ABI_NAMESPACE))]]
+#else
+#define CTRX_ABI
+#endif
 
 #endif // CTRX_CONTRACTS_HPP
@@ -0,0 +1,100 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef CTRX_COST_HPP
+#define CTRX_COST_HPP
+
+#include <atomic>
+#include <type_traits>
+
+namespace ctrx
+{
+// Cost tiers of contract checks, i.e. the complexity classes of the contract levels O_1 to O_N2
+enum class cost
+{
+    o_1 = 1,
+    o_log_n,
+    o_n,
+    o_n_log_n,
+    o_n2,
+};
+
+namespace detail
+{
+inline std::atomic<cost> runtime_max_cost{cost::o_n2};
+// The maximum of the current thread's policy, or cost{} if there is none
+inline thread_local cost thread_max_cost{};
+
+[[nodiscard]] inline auto effective_max_cost() noexcept -> cost
+{
+    cost const thread_max = thread_max_cost;
+    return thread_max != cost{} ? thread_max : runtime_max_cost.load(std::memory_order_relaxed);
+}
+
+// Whether contracts of a tier are checked at runtime. O(1) contracts always are, so that their checks don't pay for
+// this; and there is no runtime maximum in constant evaluation.
+[[nodiscard]] constexpr auto affordable(int tier) noexcept -> bool
+{
+    if (tier <= static_cast<int>(cost::o_1) || std::is_constant_evaluated())
+        return true;
+    return tier <= static_cast<int>(effective_max_cost());
+}
+} // namespace detail
+
+// Sets the cost tier up to which contracts are checked at runtime, for all threads. This can only lower the maximum
+// set by the configured level: contracts above that aren't compiled in. O(1) contracts are always checked.
+inline void set_max_cost(cost max) noexcept
+{
+    detail::runtime_max_cost.store(max, std::memory_order_relaxed);
+}
+
+// The cost tier up to which contracts are checked at runtime on the calling thread, i.e. the maximum of its
+// thread_policy if it has one, or else the one set by set_max_cost() (cost::o_n2 by default)
+[[nodiscard]] inline auto max_cost() noexcept -> cost
+{
+    return detail::effective_max_cost();
+}
+
+// Sets the cost tier up to which contracts are checked at runtime on the current thread, for the lifetime of the
+// policy, e.g. to skip expensive checks on latency-critical threads. It takes precedence over set_max_cost(), and
+// policies nest: the enclosing one is restored on destruction. O(1) contracts are always checked.
+class thread_policy
+{
+  public:
+    explicit thread_policy(cost max) noexcept
+        : m_enclosing(detail::thread_max_cost)
+    {
+        detail::thread_max_cost = max;
+    }
+
+    thread_policy(thread_policy const&)                    = delete;
+    auto operator=(thread_policy const&) -> thread_policy& = delete;
+
+    ~thread_policy() { detail::thread_max_cost = m_enclosing; }
+
+  private:
+    cost m_enclosing;
+};
+} // namespace ctrx
+
+#endif // CTRX_COST_HPP
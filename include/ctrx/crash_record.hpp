@@ -0,0 +1,186 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_CRASH_RECORD_HPP
+#define CTRX_CRASH_RECORD_HPP
+
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/site_id.hpp"
+
+#include <atomic>
+#include <source_location>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#define CTRX_DETAIL_HAS_POSIX_WRITE
+#endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+// File descriptor that TERMINATE mode writes its crash record to before terminating (negative to disable)
+#if !defined(CTRX_CONFIG_CRASH_RECORD_FD)
+#define CTRX_CONFIG_CRASH_RECORD_FD 2
+#endif
+
+namespace ctrx
+{
+namespace detail
+{
+inline std::atomic<int> crash_record_fd{CTRX_CONFIG_CRASH_RECORD_FD};
+
+// Fixed-size, allocation-free text buffer; silently truncates
+class crash_record_buffer
+{
+  public:
+    inline void append(char const* str) noexcept
+    {
+        while (*str != '\0' && m_size < sizeof(m_data))
+            m_data[m_size++] = *str++;
+    }
+
+    inline void append(std::uint_least64_t value) noexcept
+    {
+        char        digits[20];
+        std::size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count > 0 && m_size < sizeof(m_data))
+            m_data[m_size++] = digits[--count];
+    }
+
+    [[nodiscard]] inline auto data() const noexcept -> char const* { return m_data; }
+    [[nodiscard]] inline auto size() const noexcept -> std::size_t { return m_size; }
+
+  private:
+    char        m_data[1024];
+    std::size_t m_size = 0;
+};
+
+// Appends the thread id and a line break, and writes the record to fd
+inline void flush_crash_record(int fd, crash_record_buffer& record) noexcept
+{
+#if defined(CTRX_DETAIL_HAS_POSIX_WRITE)
+#if defined(__linux__) && defined(SYS_gettid)
+    record.append(" [tid ");
+    record.append(static_cast<std::uint_least64_t>(::syscall(SYS_gettid)));
+    record.append("]");
+#endif
+    record.append("\n");
+
+    char const* data = record.data();
+    std::size_t left = record.size();
+    while (left > 0)
+    {
+        auto const written = ::write(fd, data, left);
+        if (written <= 0)
+            break;
+        data += written;
+        left -= static_cast<std::size_t>(written);
+    }
+#else
+    (void)fd;
+    (void)record;
+#endif
+}
+
+// Writes a single-line crash record to fd. Only uses async-signal-safe syscalls; doesn't allocate or lock.
+CTRX_DETAIL_COLD inline void write_crash_record(int                         fd,
+                                                char const*                 type,
+                                                char const*                 condition,
+                                                std::source_location const& sloc) noexcept
+{
+    if (fd < 0)
+        return;
+
+    crash_record_buffer record;
+    record.append("ctrx: ");
+    record.append(type);
+    record.append(" violation: ");
+    record.append(condition);
+    record.append(" at ");
+    record.append(sloc.file_name());
+    record.append(":");
+    record.append(std::uint_least64_t{sloc.line()});
+    flush_crash_record(fd, record);
+}
+
+// Same as above, for builds with stripped strings that only know the site id of the violated contract
+CTRX_DETAIL_COLD inline void write_crash_record(int fd, char const* type, site_id_t site) noexcept
+{
+    if (fd < 0)
+        return;
+
+    crash_record_buffer record;
+    record.append("ctrx: ");
+    record.append(type);
+    record.append(" violation: site ");
+    record.append(format_site_id(site).data());
+    flush_crash_record(fd, record);
+}
+
+// Entry point used by TERMINATE mode
+CTRX_DETAIL_COLD inline void write_crash_record(char const*                 type,
+                                                char const*                 condition,
+                                                std::source_location const& sloc) noexcept
+{
+    write_crash_record(crash_record_fd.load(std::memory_order_relaxed), type, condition, sloc);
+}
+
+// Entry point used by TERMINATE mode for contracts with formatted messages
+CTRX_DETAIL_COLD inline void write_crash_record(char const*                 type,
+                                                std::string const&          condition,
+                                                std::source_location const& sloc) noexcept
+{
+    write_crash_record(type, condition.c_str(), sloc);
+}
+
+// Entry point used by TERMINATE and ASSERT mode if strings are stripped
+CTRX_DETAIL_COLD inline void write_crash_record(char const* type, site_id_t site) noexcept
+{
+    write_crash_record(crash_record_fd.load(std::memory_order_relaxed), type, site);
+}
+} // namespace detail
+
+// Sets the file descriptor TERMINATE mode writes its crash record to; a negative descriptor disables the record
+inline void set_crash_record_fd(int fd) noexcept
+{
+    detail::crash_record_fd.store(fd, std::memory_order_relaxed);
+}
+
+// Returns the file descriptor TERMINATE mode writes its crash record to
+[[nodiscard]] inline auto crash_record_fd() noexcept -> int
+{
+    return detail::crash_record_fd.load(std::memory_order_relaxed);
+}
+} // namespace ctrx
+
+#endif // CTRX_CRASH_RECORD_HPP
@@ -0,0 +1,55 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_DETAIL_ATTRIBUTES_HPP
+#define CTRX_DETAIL_ATTRIBUTES_HPP
+
+// Marks functions that only run when a contract is violated, keeping them out of the hot path
+#if defined(__GNUC__)
+#define CTRX_DETAIL_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define CTRX_DETAIL_COLD [[msvc::noinline]]
+#else
+#define CTRX_DETAIL_COLD
+#endif
+
+// Prevents inlining, e.g. for functions that need their own stack frame
+#if defined(__GNUC__)
+#define CTRX_DETAIL_NOINLINE [[gnu::noinline]]
+#elif defined(_MSC_VER)
+#define CTRX_DETAIL_NOINLINE [[msvc::noinline]]
+#else
+#define CTRX_DETAIL_NOINLINE
+#endif
+
+// Forces inlining of small functions whose checks would otherwise keep them from being inlined into loops
+#if defined(__GNUC__)
+#define CTRX_DETAIL_ALWAYS_INLINE [[gnu::always_inline]]
+#elif defined(_MSC_VER)
+#define CTRX_DETAIL_ALWAYS_INLINE [[msvc::forceinline]]
+#else
+#define CTRX_DETAIL_ALWAYS_INLINE
+#endif
+
+#endif // CTRX_DETAIL_ATTRIBUTES_HPP
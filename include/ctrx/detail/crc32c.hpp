@@ -0,0 +1,196 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_DETAIL_CRC32C_HPP
+#define CTRX_DETAIL_CRC32C_HPP
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <nmmintrin.h>
+#define CTRX_DETAIL_HAS_CRC32C_X86
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CTRX_DETAIL_HAS_CRC32C_ARM
+#endif
+
+namespace ctrx::detail
+{
+// CRC-32C (Castagnoli), the checksum the SSE4.2 and ARMv8 CRC32 instructions compute. The functions below update the
+// raw register, without the initial and final inversion.
+inline constexpr std::uint32_t crc32c_polynomial = 0x82f63b78u; // reflected
+
+// Tables for slicing-by-8: tables[0] is the bytewise table, and tables[k] that of a byte followed by k zero bytes
+[[nodiscard]] consteval auto make_crc32c_tables() -> std::array<std::array<std::uint32_t, 256>, 8>
+{
+    std::array<std::array<std::uint32_t, 256>, 8> tables{};
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ ((crc & 1u) != 0 ? crc32c_polynomial : 0u);
+        tables[0][i] = crc;
+    }
+    for (std::size_t k = 1; k < tables.size(); ++k)
+        for (std::size_t i = 0; i < 256; ++i)
+            tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xffu];
+    return tables;
+}
+inline constexpr auto crc32c_tables = make_crc32c_tables();
+
+[[nodiscard]] constexpr auto crc32c_byte(std::uint32_t crc, unsigned char byte) noexcept -> std::uint32_t
+{
+    return (crc >> 8) ^ crc32c_tables[0][(crc ^ byte) & 0xffu];
+}
+
+[[nodiscard]] inline auto crc32c_portable(std::uint32_t crc, unsigned char const* bytes, std::size_t size) noexcept
+    -> std::uint32_t
+{
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        // Little endian loads, which compilers merge into single ones where that's native
+        auto const load = [](unsigned char const* p)
+        {
+            return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8
+                   | static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+        };
+        std::uint32_t const low  = load(bytes) ^ crc;
+        std::uint32_t const high = load(bytes + 4);
+        crc = crc32c_tables[7][low & 0xffu] ^ crc32c_tables[6][(low >> 8) & 0xffu]
+              ^ crc32c_tables[5][(low >> 16) & 0xffu] ^ crc32c_tables[4][low >> 24] ^ crc32c_tables[3][high & 0xffu]
+              ^ crc32c_tables[2][(high >> 8) & 0xffu] ^ crc32c_tables[1][(high >> 16) & 0xffu]
+              ^ crc32c_tables[0][high >> 24];
+    }
+    for (; size > 0; --size, ++bytes)
+        crc = crc32c_byte(crc, *bytes);
+    return crc;
+}
+
+#if defined(CTRX_DETAIL_HAS_CRC32C_X86) || defined(CTRX_DETAIL_HAS_CRC32C_ARM)
+// The instructions have a latency of three cycles, but a throughput of one per cycle: large buffers are split into
+// three interleaved streams of crc32c_block bytes each, which are then combined. The register of the first stream is
+// advanced over the length of the others by a linear map, which is given by its image of each bit.
+inline constexpr std::size_t crc32c_block = 4096;
+
+[[nodiscard]] consteval auto make_crc32c_shift() -> std::array<std::uint32_t, 32>
+{
+    std::array<std::uint32_t, 32> columns{};
+    for (std::size_t bit = 0; bit < columns.size(); ++bit)
+    {
+        std::uint32_t crc = std::uint32_t{1} << bit;
+        for (std::size_t i = 0; i < crc32c_block; ++i)
+            crc = crc32c_byte(crc, 0);
+        columns[bit] = crc;
+    }
+    return columns;
+}
+inline constexpr auto crc32c_shift = make_crc32c_shift();
+
+[[nodiscard]] inline auto crc32c_shift_block(std::uint32_t crc) noexcept -> std::uint32_t
+{
+    std::uint32_t shifted = 0;
+    for (auto const column : crc32c_shift)
+    {
+        shifted ^= column & (0u - (crc & 1u));
+        crc >>= 1;
+    }
+    return shifted;
+}
+
+#if defined(CTRX_DETAIL_HAS_CRC32C_X86)
+#define CTRX_DETAIL_CRC32C_TARGET [[gnu::target("sse4.2")]]
+#define CTRX_DETAIL_CRC32C_U64(CRC, WORD) static_cast<std::uint32_t>(_mm_crc32_u64(CRC, WORD))
+#define CTRX_DETAIL_CRC32C_U8(CRC, BYTE) _mm_crc32_u8(CRC, BYTE)
+#else
+#define CTRX_DETAIL_CRC32C_TARGET
+#define CTRX_DETAIL_CRC32C_U64(CRC, WORD) __crc32cd(CRC, WORD)
+#define CTRX_DETAIL_CRC32C_U8(CRC, BYTE) __crc32cb(CRC, BYTE)
+#endif
+
+[[nodiscard]] CTRX_DETAIL_CRC32C_TARGET inline auto
+crc32c_hardware(std::uint32_t crc, unsigned char const* bytes, std::size_t size) noexcept -> std::uint32_t
+{
+    auto const word = [](unsigned char const* p)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        return w;
+    };
+    for (; size >= 3 * crc32c_block; size -= 3 * crc32c_block, bytes += 3 * crc32c_block)
+    {
+        std::uint32_t crc1 = 0;
+        std::uint32_t crc2 = 0;
+        for (std::size_t i = 0; i < crc32c_block; i += 8)
+        {
+            crc  = CTRX_DETAIL_CRC32C_U64(crc, word(bytes + i));
+            crc1 = CTRX_DETAIL_CRC32C_U64(crc1, word(bytes + crc32c_block + i));
+            crc2 = CTRX_DETAIL_CRC32C_U64(crc2, word(bytes + 2 * crc32c_block + i));
+        }
+        crc = crc32c_shift_block(crc32c_shift_block(crc) ^ crc1) ^ crc2;
+    }
+    for (; size >= 8; size -= 8, bytes += 8)
+        crc = CTRX_DETAIL_CRC32C_U64(crc, word(bytes));
+    for (; size > 0; --size, ++bytes)
+        crc = CTRX_DETAIL_CRC32C_U8(crc, *bytes);
+    return crc;
+}
+#undef CTRX_DETAIL_CRC32C_TARGET
+#undef CTRX_DETAIL_CRC32C_U64
+#undef CTRX_DETAIL_CRC32C_U8
+#endif
+
+// Whether the hardware implementation is available; on x86 without -msse4.2, this is detected once, at runtime
+[[nodiscard]] inline auto crc32c_hardware_available() noexcept -> bool
+{
+#if defined(CTRX_DETAIL_HAS_CRC32C_ARM) || (defined(CTRX_DETAIL_HAS_CRC32C_X86) && defined(__SSE4_2__))
+    return true;
+#elif defined(CTRX_DETAIL_HAS_CRC32C_X86)
+    static bool const available = []
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2") != 0;
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+// CRC-32C of size bytes
+[[nodiscard]] inline auto crc32c(void const* data, std::size_t size) noexcept -> std::uint32_t
+{
+    auto const* bytes = static_cast<unsigned char const*>(data);
+#if defined(CTRX_DETAIL_HAS_CRC32C_X86) || defined(CTRX_DETAIL_HAS_CRC32C_ARM)
+    if (crc32c_hardware_available())
+        return ~crc32c_hardware(~std::uint32_t{0}, bytes, size);
+#endif
+    return ~crc32c_portable(~std::uint32_t{0}, bytes, size);
+}
+} // namespace ctrx::detail
+
+#endif // CTRX_DETAIL_CRC32C_HPP
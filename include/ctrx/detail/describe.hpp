@@ -0,0 +1,63 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_DETAIL_DESCRIBE_HPP
+#define CTRX_DETAIL_DESCRIBE_HPP
+
+#include "ctrx/detail/attributes.hpp"
+
+#include <concepts>
+#include <optional>
+#include <string>
+
+namespace ctrx::detail
+{
+// ": <description>" of a failed condition's result. Only called on failure, so kept out of the contract sites.
+template<typename Result>
+[[nodiscard]] CTRX_DETAIL_COLD inline auto describe_result(Result const& result) -> std::string
+{
+    return ": " + std::string(result.describe());
+}
+
+// Whether a condition's result can describe itself (see predicates.hpp)
+template<typename Result>
+concept describable = requires(Result const& result) {
+    {
+        result.describe()
+    } -> std::convertible_to<std::string>;
+};
+
+// Detail message of a condition whose result can describe itself, or nullopt if it passed. condition(0) evaluates it;
+// the result is bound by reference, so that conditions naming a describable object don't copy it.
+template<typename Condition>
+[[nodiscard]] constexpr auto describe_if_failed(Condition&& condition) -> std::optional<std::string>
+{
+    if (auto&& result = condition(0))
+        return std::nullopt;
+    else
+        return describe_result(result);
+}
+} // namespace ctrx::detail
+
+#endif // CTRX_DETAIL_DESCRIBE_HPP
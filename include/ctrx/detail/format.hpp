@@ -0,0 +1,86 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_DETAIL_FORMAT_HPP
+#define CTRX_DETAIL_FORMAT_HPP
+
+#include <string>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#else
+#include <cstddef>
+#include <ios>
+#include <sstream>
+#include <string_view>
+#endif
+
+namespace ctrx::detail
+{
+#if defined(__cpp_lib_format)
+// Formats the message of a contract with a formatted message, e.g. " (bad size 3 for 42)"
+template<typename... Args>
+[[nodiscard]] inline auto format_message(std::format_string<Args const&...> format, Args const&... args)
+    -> std::string
+{
+    return " (" + std::format(format, args...) + ")";
+}
+#else
+// Stand-in for standard libraries without std::format: every replacement field (e.g. "{}"; format specifications
+// are ignored) is replaced by the next argument as written by operator<<, and "{{" and "}}" by single braces
+template<typename... Args>
+[[nodiscard]] inline auto format_message(std::string_view format, Args const&... args) -> std::string
+{
+    std::ostringstream out;
+    out << std::boolalpha << " (";
+    std::size_t next       = 0;
+    auto const  write_next = [&]
+    {
+        std::size_t index = 0;
+        ((index++ == next ? (void)(out << args) : (void)0), ...);
+        ++next;
+    };
+    for (std::size_t i = 0; i < format.size(); ++i)
+    {
+        if ((format[i] == '{' || format[i] == '}') && i + 1 < format.size() && format[i + 1] == format[i])
+            out << format[i++];
+        else if (format[i] == '{')
+        {
+            auto const end = format.find('}', i);
+            if (end == std::string_view::npos)
+                break;
+            write_next();
+            i = end;
+        }
+        else
+            out << format[i];
+    }
+    out << ')';
+    return out.str();
+}
+#endif
+} // namespace ctrx::detail
+
+#endif // CTRX_DETAIL_FORMAT_HPP
@@ -31,8 +31,13 @@ namespace ctrx
 {
 struct assertion_violation : contract_violation
 {
-    inline explicit assertion_violation(std::string_view what, std::source_location sloc)
-        : contract_violation(contract_type::assertion, what, std::move(sloc))
+    inline explicit assertion_violation(std::string_view what, std::source_location sloc, raw_stacktrace trace = {})
+        : contract_violation(contract_type::assertion, what, std::move(sloc), trace)
+    {
+    }
+
+    inline explicit assertion_violation(site_id_t site, std::string_view message, raw_stacktrace trace = {})
+        : contract_violation(contract_type::assertion, site, message, trace)
     {
     }
 };
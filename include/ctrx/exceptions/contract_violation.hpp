@@ -26,6 +26,8 @@
 #define CTRX_TESTS_CONTRACT_VIOLATION_HPP
 
 #include "ctrx/contract_type.hpp"
+#include "ctrx/site_id.hpp"
+#include "ctrx/stacktrace.hpp"
 
 #include <source_location>
 #include <stdexcept>
@@ -38,16 +40,34 @@ namespace ctrx
 class contract_violation : public std::exception
 {
   public:
-    inline explicit contract_violation(contract_type type, std::string_view what, std::source_location sloc)
+    inline explicit contract_violation(contract_type        type,
+                                       std::string_view     what,
+                                       std::source_location sloc,
+                                       raw_stacktrace       trace = {})
         : m_type(type)
         , m_what(std::string(sloc.file_name()) + ":" + std::to_string(sloc.line()) + ":" + std::to_string(sloc.column())
                  + " " + std::string(what) + " (in " + sloc.function_name() + ")")
         , m_sloc(std::move(sloc))
+        , m_trace(trace)
+    {
+    }
+
+    // Used if strings are stripped: the violation is only identified by its site id
+    inline explicit contract_violation(contract_type    type,
+                                       site_id_t        site,
+                                       std::string_view message,
+                                       raw_stacktrace   trace = {})
+        : m_type(type)
+        , m_what(detail::site_message(site) + std::string(message))
+        , m_site_id(site)
+        , m_trace(trace)
     {
     }
 
     [[nodiscard]] constexpr auto type() const noexcept -> contract_type { return m_type; }
     [[nodiscard]] constexpr auto source_location() const noexcept -> std::source_location const& { return m_sloc; }
+    [[nodiscard]] constexpr auto stacktrace() const noexcept -> raw_stacktrace const& { return m_trace; }
+    [[nodiscard]] constexpr auto site_id() const noexcept -> site_id_t { return m_site_id; }
 
     [[nodiscard]] inline auto what() const noexcept -> char const* override { return m_what.c_str(); }
 
@@ -55,6 +75,10 @@ class contract_violation : public std::exception
     contract_type        m_type;
     std::string          m_what;
     std::source_location m_sloc;
+    site_id_t            m_site_id = 0;
+    // Always present (and empty unless CTRX_CONFIG_CAPTURE_STACKTRACE is defined), so that the layout of the exception
+    // doesn't depend on the configuration of the translation unit that throws it
+    raw_stacktrace m_trace;
 };
 } // namespace ctrx
 
@@ -0,0 +1,46 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_INVARIANT_VIOLATION_HPP
+#define CTRX_INVARIANT_VIOLATION_HPP
+
+#include "ctrx/exceptions/contract_violation.hpp"
+
+namespace ctrx
+{
+struct invariant_violation : contract_violation
+{
+    inline explicit invariant_violation(std::string_view what, std::source_location sloc, raw_stacktrace trace = {})
+        : contract_violation(contract_type::invariant, what, std::move(sloc), trace)
+    {
+    }
+
+    inline explicit invariant_violation(site_id_t site, std::string_view message, raw_stacktrace trace = {})
+        : contract_violation(contract_type::invariant, site, message, trace)
+    {
+    }
+};
+} // namespace ctrx
+
+#endif // CTRX_INVARIANT_VIOLATION_HPP
@@ -31,8 +31,13 @@ namespace ctrx
 {
 struct postcondition_violation : contract_violation
 {
-    inline explicit postcondition_violation(std::string_view what, std::source_location sloc)
-        : contract_violation(contract_type::assertion, what, std::move(sloc))
+    inline explicit postcondition_violation(std::string_view what, std::source_location sloc, raw_stacktrace trace = {})
+        : contract_violation(contract_type::postcondition, what, std::move(sloc), trace)
+    {
+    }
+
+    inline explicit postcondition_violation(site_id_t site, std::string_view message, raw_stacktrace trace = {})
+        : contract_violation(contract_type::postcondition, site, message, trace)
     {
     }
 };
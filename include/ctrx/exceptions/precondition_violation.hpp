@@ -31,8 +31,13 @@ namespace ctrx
 {
 struct precondition_violation : contract_violation
 {
-    inline explicit precondition_violation(std::string_view what, std::source_location sloc)
-        : contract_violation(contract_type::assertion, what, std::move(sloc))
+    inline explicit precondition_violation(std::string_view what, std::source_location sloc, raw_stacktrace trace = {})
+        : contract_violation(contract_type::precondition, what, std::move(sloc), trace)
+    {
+    }
+
+    inline explicit precondition_violation(site_id_t site, std::string_view message, raw_stacktrace trace = {})
+        : contract_violation(contract_type::precondition, site, message, trace)
     {
     }
 };
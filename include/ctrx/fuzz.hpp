@@ -0,0 +1,198 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_FUZZ_HPP
+#define CTRX_FUZZ_HPP
+
+#include "ctrx/crash_record.hpp"
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/site_id.hpp"
+
+#include <atomic>
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(CTRX_DETAIL_HAS_POSIX_WRITE)
+#include <fcntl.h>
+#endif
+
+// Number of distinct contract sites FUZZ mode can tell apart (rounded up to a power of two)
+#if !defined(CTRX_CONFIG_FUZZ_MAX_SITES)
+#define CTRX_CONFIG_FUZZ_MAX_SITES 4096
+#endif
+
+// Environment variable naming the file of known site ids that FUZZ mode reads and appends to
+#if !defined(CTRX_CONFIG_FUZZ_SITES_ENV)
+#define CTRX_CONFIG_FUZZ_SITES_ENV "CTRX_FUZZ_SITES"
+#endif
+
+namespace ctrx
+{
+namespace detail
+{
+[[nodiscard]] constexpr auto fuzz_table_size(std::size_t sites) noexcept -> std::size_t
+{
+    std::size_t size = 1;
+    while (size < sites)
+        size *= 2;
+    return size;
+}
+
+// Open-addressing set of site ids with a hit counter each. Lock-free, and never allocates.
+class fuzz_site_table
+{
+  public:
+    // Adds the site without counting a hit; returns false if it was already known
+    inline auto add(site_id_t site) noexcept -> bool { return slot_of(site).second; }
+
+    // Counts a hit of the site; returns true if it wasn't known before (or if the table is full)
+    inline auto hit(site_id_t site) noexcept -> bool
+    {
+        auto const [s, added] = slot_of(site);
+        if (s != nullptr)
+            s->hits.fetch_add(1, std::memory_order_relaxed);
+        return added;
+    }
+
+    [[nodiscard]] inline auto hits(site_id_t site) const noexcept -> std::uint_least64_t
+    {
+        for (std::size_t i = 0, index = site & mask; i < size; ++i, index = (index + 1) & mask)
+        {
+            auto const current = m_slots[index].key.load(std::memory_order_acquire);
+            if (current == site)
+                return m_slots[index].hits.load(std::memory_order_relaxed);
+            if (current == 0)
+                break;
+        }
+        return 0;
+    }
+
+  private:
+    struct slot
+    {
+        std::atomic<std::uint_least64_t> key{0};
+        std::atomic<std::uint_least64_t> hits{0};
+    };
+
+    static constexpr std::size_t size = fuzz_table_size(CTRX_CONFIG_FUZZ_MAX_SITES);
+    static constexpr std::size_t mask = size - 1;
+
+    // Site ids are hashes already, so their low bits are used as slot index directly. They are never 0, which marks
+    // free slots.
+    inline auto slot_of(site_id_t site) noexcept -> std::pair<slot*, bool>
+    {
+        for (std::size_t i = 0, index = site & mask; i < size; ++i, index = (index + 1) & mask)
+        {
+            std::uint_least64_t expected = 0;
+            if (m_slots[index].key.compare_exchange_strong(expected, site, std::memory_order_acq_rel))
+                return {&m_slots[index], true};
+            if (expected == site)
+                return {&m_slots[index], false};
+        }
+        return {nullptr, true};
+    }
+
+    slot m_slots[size];
+};
+
+// Reads the site ids ("0x1234abcd5678ef90", one per line) of a known sites file; anything else on a line is ignored
+inline void load_fuzz_sites(fuzz_site_table& table, char const* path) noexcept
+{
+    std::FILE* file = std::fopen(path, "r");
+    if (file == nullptr)
+        return;
+    char line[256];
+    while (std::fgets(line, sizeof(line), file) != nullptr)
+    {
+        char* end = nullptr;
+        if (line[0] == '0' && (line[1] == 'x' || line[1] == 'X'))
+        {
+            auto const id = std::strtoull(line, &end, 16);
+            if (end != line + 2 && id != 0)
+                table.add(static_cast<site_id_t>(id));
+        }
+    }
+    std::fclose(file);
+}
+
+[[nodiscard]] inline auto fuzz_sites_path() noexcept -> char const*
+{
+    return std::getenv(CTRX_CONFIG_FUZZ_SITES_ENV);
+}
+
+// The sites known to FUZZ mode, preloaded from the known sites file on first use
+[[nodiscard]] inline auto fuzz_sites() noexcept -> fuzz_site_table&
+{
+    static fuzz_site_table table;
+    static bool const      loaded = [] {
+        if (char const* path = fuzz_sites_path(); path != nullptr)
+            load_fuzz_sites(table, path);
+        return true;
+    }();
+    (void)loaded;
+    return table;
+}
+
+// Appends a site id to the known sites file. A single O_APPEND write, so concurrent fuzzing jobs don't interleave.
+inline void record_fuzz_site(char const* path, site_id_t site) noexcept
+{
+#if defined(CTRX_DETAIL_HAS_POSIX_WRITE)
+    int const fd = ::open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return;
+    auto line = format_site_id(site);
+    line.back() = '\n';
+    (void)::write(fd, line.data(), line.size());
+    ::close(fd);
+#else
+    (void)path;
+    (void)site;
+#endif
+}
+
+// Entry point used by FUZZ mode. Known sites are only counted; the first violation of any other site is recorded
+// and aborts, which fuzzers treat as a crash of the current input.
+CTRX_DETAIL_COLD inline void fuzz_violation(char const* type, site_id_t site) noexcept
+{
+    if (!fuzz_sites().hit(site))
+        return;
+    if (char const* path = fuzz_sites_path(); path != nullptr)
+        record_fuzz_site(path, site);
+    write_crash_record(type, site);
+    std::abort();
+}
+} // namespace detail
+
+// Returns how often FUZZ mode saw the (known) site violated in this process
+[[nodiscard]] inline auto fuzz_hits(site_id_t site) noexcept -> std::uint_least64_t
+{
+    return detail::fuzz_sites().hits(site);
+}
+} // namespace ctrx
+
+#endif // CTRX_FUZZ_HPP
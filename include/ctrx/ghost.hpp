@@ -0,0 +1,184 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#ifndef CTRX_GHOST_HPP
+#define CTRX_GHOST_HPP
+
+#include "ctrx/contract_type.hpp"
+#include "ctrx/contracts.hpp"
+
+#include <type_traits>
+#include <utility>
+
+// Lets an empty ghost take no space as a member; MSVC ignores the standard attribute
+#if defined(_MSC_VER)
+#define CTRX_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define CTRX_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+namespace ctrx
+{
+// Contract levels, as named in the contract macros. default_ has a trailing underscore, as default is a keyword.
+enum class level
+{
+    default_,
+    audit,
+    axiom,
+    o_1,
+    o_log_n,
+    o_n,
+    o_n_log_n,
+    o_n2,
+};
+
+namespace detail
+{
+// Cost tiers of the levels, in the order of ctrx::level
+inline constexpr int level_tiers[] = {
+    CTRX_DETAIL_TIER_DEFAULT,
+    CTRX_DETAIL_TIER_AUDIT,
+    CTRX_DETAIL_TIER_AXIOM,
+    CTRX_DETAIL_TIER_O_1,
+    CTRX_DETAIL_TIER_O_LOG_N,
+    CTRX_DETAIL_TIER_O_N,
+    CTRX_DETAIL_TIER_O_N_LOG_N,
+    CTRX_DETAIL_TIER_O_N2,
+};
+
+// Whether contracts in a mode are ever evaluated; OFF and ASSUME (and ASSERT with NDEBUG) never evaluate them
+[[nodiscard]] consteval auto evaluated_mode(int mode) noexcept -> bool
+{
+#if defined(NDEBUG)
+    if (mode == CTRX_DETAIL_MODE_NUM_ASSERT)
+        return false;
+#endif
+    return mode != CTRX_DETAIL_MODE_NUM_OFF && mode != CTRX_DETAIL_MODE_NUM_ASSUME;
+}
+
+// The highest cost tier of the contracts of a type that are evaluated in this configuration, or 0 if none are
+[[nodiscard]] consteval auto evaluated_tier(contract_type type) noexcept -> int
+{
+    switch (type)
+    {
+    case contract_type::precondition:
+        return evaluated_mode(CTRX_DETAIL_MODE_NUM(PRECONDITION)) ? CTRX_DETAIL_MAX_TIER(PRECONDITION) : 0;
+    case contract_type::postcondition:
+        return evaluated_mode(CTRX_DETAIL_MODE_NUM(POSTCONDITION)) ? CTRX_DETAIL_MAX_TIER(POSTCONDITION) : 0;
+    case contract_type::assertion:
+        return evaluated_mode(CTRX_DETAIL_MODE_NUM(ASSERTION)) ? CTRX_DETAIL_MAX_TIER(ASSERTION) : 0;
+    case contract_type::invariant:
+        return evaluated_mode(CTRX_DETAIL_MODE_NUM(INVARIANT)) ? CTRX_DETAIL_MAX_TIER(INVARIANT) : 0;
+    }
+    return 0;
+}
+} // namespace detail
+
+// Within the configuration's own inline namespace (which also tells ASSERT mode with and without NDEBUG apart), as the
+// layout of ghosts depends on it. Types that hold ghosts don't inherit it, though: declare them within
+// CTRX_ABI_NAMESPACE as well if they are shared between differently configured libraries.
+inline namespace CTRX_ABI_NAMESPACE
+{
+// Whether contracts of the given type and level are evaluated in this configuration
+template<contract_type Type, level Level>
+inline constexpr bool evaluated_v = detail::level_tiers[static_cast<int>(Level)] <= detail::evaluated_tier(Type);
+
+// Auxiliary state that only exists for checking contracts of the given type and level, such as element counts,
+// generation numbers or owner thread ids. If those contracts are evaluated, it holds a T; otherwise, it is empty, and
+// its accessors are only declared: contract conditions that aren't evaluated may still refer to it, but anything else
+// fails to link. Update it with CTRX_GHOST, which vanishes along with the state, and declare it as member with
+// CTRX_NO_UNIQUE_ADDRESS, so that it takes no space when it's empty.
+template<typename T, contract_type Type = contract_type::invariant, level Level = level::default_>
+class ghost
+{
+  public:
+    using value_type = T;
+
+    static constexpr bool enabled = evaluated_v<Type, Level>;
+
+    constexpr ghost() = default;
+    constexpr ghost(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : m_value(std::move(value))
+    {
+    }
+
+    constexpr auto operator=(T value) noexcept(std::is_nothrow_move_assignable_v<T>) -> ghost&
+    {
+        m_value = std::move(value);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto get() noexcept -> T& { return m_value; }
+    [[nodiscard]] constexpr auto get() const noexcept -> T const& { return m_value; }
+    [[nodiscard]] constexpr auto operator*() noexcept -> T& { return m_value; }
+    [[nodiscard]] constexpr auto operator*() const noexcept -> T const& { return m_value; }
+    [[nodiscard]] constexpr auto operator->() noexcept -> T* { return &m_value; }
+    [[nodiscard]] constexpr auto operator->() const noexcept -> T const* { return &m_value; }
+
+    constexpr operator T const&() const noexcept { return m_value; }
+
+  private:
+    T m_value{};
+};
+
+template<typename T, contract_type Type, level Level>
+    requires(!evaluated_v<Type, Level>)
+class ghost<T, Type, Level>
+{
+  public:
+    using value_type = T;
+
+    static constexpr bool enabled = false;
+
+    constexpr ghost() = default;
+    constexpr ghost(T const&) noexcept {}
+
+    constexpr auto operator=(T const&) noexcept -> ghost& { return *this; }
+
+    // Only for contract conditions that aren't evaluated; there is no T to refer to
+    [[nodiscard]] auto get() noexcept -> T&;
+    [[nodiscard]] auto get() const noexcept -> T const&;
+    [[nodiscard]] auto operator*() noexcept -> T&;
+    [[nodiscard]] auto operator*() const noexcept -> T const&;
+    [[nodiscard]] auto operator->() noexcept -> T*;
+    [[nodiscard]] auto operator->() const noexcept -> T const*;
+
+    operator T const&() const noexcept;
+};
+} // namespace CTRX_ABI_NAMESPACE
+} // namespace ctrx
+
+// Runs the statement (or expression) if GHOST, a ctrx::ghost, holds state; otherwise, it is discarded unevaluated, e.g.
+// CTRX_GHOST(m_pushes, ++*m_pushes)
+#define CTRX_GHOST(GHOST, ...)                                                                                         \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if constexpr (std::remove_cvref_t<decltype(GHOST)>::enabled)                                                   \
+        {                                                                                                              \
+            __VA_ARGS__;                                                                                               \
+        }                                                                                                              \
+    } while (false)
+
+#endif // CTRX_GHOST_HPP
@@ -0,0 +1,83 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_INVARIANT_GUARD_HPP
+#define CTRX_INVARIANT_GUARD_HPP
+
+#include <exception>
+#include <type_traits>
+
+namespace ctrx::detail
+{
+// Checks an invariant on construction (unless only exit is checked) and on destruction, i.e. on every exit path of the
+// enclosing scope. If the scope is left by an exception, the invariant isn't checked: it may legitimately be broken
+// while unwinding, and reporting it by throwing would terminate the program.
+template<typename Check>
+class invariant_guard
+{
+  public:
+    constexpr invariant_guard(Check check, bool check_on_entry, bool active)
+        : m_check(check)
+        , m_active(active)
+        , m_uncaught_exceptions(std::is_constant_evaluated() ? 0 : std::uncaught_exceptions())
+    {
+        if (m_active && check_on_entry)
+            m_check();
+    }
+
+    invariant_guard(invariant_guard const&)                    = delete;
+    auto operator=(invariant_guard const&) -> invariant_guard& = delete;
+
+    constexpr ~invariant_guard() noexcept(false)
+    {
+        if (!m_active)
+            return;
+        if (!std::is_constant_evaluated() && std::uncaught_exceptions() > m_uncaught_exceptions)
+            return;
+        m_check();
+    }
+
+  private:
+    Check m_check;
+    bool  m_active;
+    int   m_uncaught_exceptions;
+};
+
+template<typename Tag>
+inline thread_local unsigned invariant_sample_counter = 0;
+
+// Returns true for the first and then every period-th call per site and thread (and always in constant evaluation)
+template<typename Tag>
+[[nodiscard]] constexpr auto sample_invariant(unsigned period) noexcept -> bool
+{
+    if (period <= 1 || std::is_constant_evaluated())
+        return true;
+    auto&      counter = invariant_sample_counter<Tag>;
+    bool const sample  = counter == 0;
+    counter            = counter + 1 == period ? 0 : counter + 1;
+    return sample;
+}
+} // namespace ctrx::detail
+
+#endif // CTRX_INVARIANT_GUARD_HPP
@@ -0,0 +1,323 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_POLICY_HPP
+#define CTRX_POLICY_HPP
+
+#include "ctrx/detail/attributes.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+// Environment variable with policy rules, e.g. "src/match/*:off;*:audit"
+#if !defined(CTRX_CONFIG_POLICY_ENV)
+#define CTRX_CONFIG_POLICY_ENV "CTRX_POLICY"
+#endif
+
+// Environment variable naming a file with further policy rules, one per line
+#if !defined(CTRX_CONFIG_POLICY_FILE_ENV)
+#define CTRX_CONFIG_POLICY_FILE_ENV "CTRX_POLICY_FILE"
+#endif
+
+namespace ctrx
+{
+namespace detail
+{
+// Highest cost tier a policy rule lets through; 0 skips all contracts, including O(1) ones
+inline constexpr int policy_all = 5;
+
+struct policy_rule
+{
+    std::string pattern;
+    int         max_tier;
+};
+
+[[nodiscard]] constexpr auto is_path_separator(char c) noexcept -> bool
+{
+    return c == '/' || c == '\\';
+}
+
+// Whether the glob pattern matches all of text. '*' matches any sequence of characters, including separators, and '?'
+// any single one. Either separator matches the other.
+[[nodiscard]] constexpr auto glob_match(std::string_view pattern, std::string_view text) noexcept -> bool
+{
+    std::size_t p    = 0;
+    std::size_t t    = 0;
+    std::size_t star = std::string_view::npos; // position of the last '*' in pattern
+    std::size_t mark = 0;                      // position in text where that '*' resumes
+    while (t < text.size())
+    {
+        if (p < pattern.size()
+            && (pattern[p] == '?' || pattern[p] == text[t]
+                || (is_path_separator(pattern[p]) && is_path_separator(text[t]))))
+        {
+            ++p;
+            ++t;
+        }
+        else if (p < pattern.size() && pattern[p] == '*')
+        {
+            star = p++;
+            mark = t;
+        }
+        else if (star != std::string_view::npos)
+        {
+            p = star + 1;
+            t = ++mark;
+        }
+        else
+            return false;
+    }
+    while (p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
+
+// Whether the pattern matches the path, or a part of it that follows a separator. Relative patterns thereby match
+// wherever the build put the sources.
+[[nodiscard]] constexpr auto path_match(std::string_view pattern, std::string_view path) noexcept -> bool
+{
+    if (glob_match(pattern, path))
+        return true;
+    for (std::size_t i = 0; i < path.size(); ++i)
+        if (is_path_separator(path[i]) && glob_match(pattern, path.substr(i + 1)))
+            return true;
+    return false;
+}
+
+[[nodiscard]] constexpr auto trim(std::string_view s) noexcept -> std::string_view
+{
+    auto const is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+    while (!s.empty() && is_space(s.front()))
+        s.remove_prefix(1);
+    while (!s.empty() && is_space(s.back()))
+        s.remove_suffix(1);
+    return s;
+}
+
+[[nodiscard]] constexpr auto equals_ignoring_case(std::string_view a, std::string_view b) noexcept -> bool
+{
+    auto const lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [&](char x, char y) { return lower(x) == lower(y); });
+}
+
+// Maximum tier of a single setting, like the one of a build with that level; or -1 if it isn't one. Modes can't change
+// at runtime, so other than "off", they keep the contracts as they were built.
+[[nodiscard]] constexpr auto policy_setting_tier(std::string_view setting) noexcept -> int
+{
+    struct named_tier
+    {
+        std::string_view name;
+        int              tier;
+    };
+    constexpr named_tier settings[] = {
+        {"off", 0},
+        {"on", policy_all},
+        {"default", 2},
+        {"audit", 5},
+        {"axiom", 5},
+        {"o_1", 1},
+        {"o_log_n", 2},
+        {"o_n", 3},
+        {"o_n_log_n", 4},
+        {"o_n2", 5},
+        {"assert", policy_all},
+        {"assume", policy_all},
+        {"throw", policy_all},
+        {"terminate", policy_all},
+        {"handler", policy_all},
+        {"fuzz", policy_all},
+    };
+    for (auto const& s : settings)
+        if (equals_ignoring_case(s.name, setting))
+            return s.tier;
+    return -1;
+}
+
+// Appends a rule pattern:setting[,setting...], which lets through contracts up to the lowest tier of its settings.
+// Invalid rules are reported on stderr and ignored.
+inline void parse_policy_rule(std::string_view rule, std::vector<policy_rule>& rules)
+{
+    auto const colon    = rule.rfind(':');
+    auto const pattern  = trim(rule.substr(0, colon));
+    auto       settings = colon == std::string_view::npos ? std::string_view{} : rule.substr(colon + 1);
+    int        max_tier = settings.empty() || pattern.empty() ? -1 : policy_all;
+    while (max_tier >= 0 && !settings.empty())
+    {
+        auto const setting = settings.substr(0, settings.find(','));
+        settings.remove_prefix(std::min(setting.size() + 1, settings.size()));
+        int const tier = policy_setting_tier(trim(setting));
+        max_tier       = tier < 0 ? -1 : std::min(max_tier, tier);
+    }
+    if (max_tier < 0)
+    {
+        auto const length = static_cast<int>(rule.size());
+        std::fprintf(stderr, "ctrx: ignoring invalid policy rule \"%.*s\"\n", length, rule.data());
+    }
+    else
+        rules.push_back(policy_rule{std::string(pattern), max_tier});
+}
+
+// Appends the rules of text, which are separated by ';' or new lines. '#' starts a comment that ends with the line.
+inline void parse_policy(std::string_view text, std::vector<policy_rule>& rules)
+{
+    while (!text.empty())
+    {
+        auto line = text.substr(0, text.find('\n'));
+        text.remove_prefix(std::min(line.size() + 1, text.size()));
+        line = line.substr(0, line.find('#'));
+        while (!line.empty())
+        {
+            auto const rule = line.substr(0, line.find(';'));
+            line.remove_prefix(std::min(rule.size() + 1, line.size()));
+            if (!trim(rule).empty())
+                parse_policy_rule(trim(rule), rules);
+        }
+    }
+}
+
+// The rules of the process. Unless set_policy() was called first, they are read from the environment when the first
+// contract site is resolved: those of CTRX_CONFIG_POLICY_ENV first, then those of the file CTRX_CONFIG_POLICY_FILE_ENV.
+class policy_registry
+{
+  public:
+    [[nodiscard]] static inline auto instance() -> policy_registry&
+    {
+        static policy_registry registry;
+        return registry;
+    }
+
+    inline void set(std::string_view text)
+    {
+        std::lock_guard lock{m_mutex};
+        m_rules.clear();
+        parse_policy(text, m_rules);
+        m_loaded = true;
+    }
+
+    // Maximum tier of the first rule that matches file, or policy_all if none does
+    [[nodiscard]] inline auto max_tier(std::string_view file) -> int
+    {
+        std::lock_guard lock{m_mutex};
+        if (!m_loaded)
+            load();
+        for (auto const& rule : m_rules)
+            if (path_match(rule.pattern, file))
+                return rule.max_tier;
+        return policy_all;
+    }
+
+  private:
+    inline void load()
+    {
+        m_loaded = true;
+        if (char const* rules = std::getenv(CTRX_CONFIG_POLICY_ENV); rules != nullptr)
+            parse_policy(rules, m_rules);
+        if (char const* path = std::getenv(CTRX_CONFIG_POLICY_FILE_ENV); path != nullptr && *path != '\0')
+        {
+            if (std::ifstream in{path}; in)
+                parse_policy(std::string(std::istreambuf_iterator<char>(in), {}), m_rules);
+            else
+                std::fprintf(stderr, "ctrx: cannot read policy from %s\n", path);
+        }
+    }
+
+    std::mutex               m_mutex;
+    std::vector<policy_rule> m_rules;
+    bool                     m_loaded = false;
+};
+
+// Cached policy decision of a contract site
+enum class policy_decision : unsigned char
+{
+    unresolved,
+    checked,
+    skipped,
+};
+
+template<typename Tag>
+inline std::atomic<policy_decision> policy_decision_v{policy_decision::unresolved};
+
+// Decides whether a site is checked, on its first call. Reading the policy locks, allocates and reads a file; if that
+// fails, the site is checked as if no rule matched, rather than terminating the process from within a contract check.
+CTRX_DETAIL_COLD inline auto resolve_policy(std::atomic<policy_decision>& decision, char const* file, int tier) noexcept
+    -> bool
+{
+    int max_tier = policy_all;
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+    try
+    {
+        max_tier = policy_registry::instance().max_tier(file);
+    }
+    catch (std::exception const& e)
+    {
+        std::fprintf(stderr, "ctrx: cannot read the policy, checking the contracts of %s: %s\n", file, e.what());
+    }
+    catch (...)
+    {
+        std::fprintf(stderr, "ctrx: cannot read the policy, checking the contracts of %s\n", file);
+    }
+#else
+    max_tier = policy_registry::instance().max_tier(file);
+#endif
+    bool const checked = tier <= max_tier;
+    decision.store(checked ? policy_decision::checked : policy_decision::skipped, std::memory_order_relaxed);
+    return checked;
+}
+
+// Whether the policy lets the contract site identified by Tag, of the given file and tier, be checked. The policy is
+// matched against the file once, on the first call; after that, checked sites cost a single load and comparison.
+template<typename Tag>
+[[nodiscard]] constexpr auto policy_allows(char const* file, int tier) noexcept -> bool
+{
+    if (std::is_constant_evaluated())
+        return true;
+    auto const decision = policy_decision_v<Tag>.load(std::memory_order_relaxed);
+    if (decision == policy_decision::checked) [[likely]]
+        return true;
+    if (decision == policy_decision::skipped)
+        return false;
+    return resolve_policy(policy_decision_v<Tag>, file, tier);
+}
+} // namespace detail
+
+// Replaces the policy rules of the environment by the given ones, in the same syntax. Contract sites that have already
+// been executed keep their decision, so this is meant to be called at startup.
+inline void set_policy(std::string_view rules)
+{
+    detail::policy_registry::instance().set(rules);
+}
+} // namespace ctrx
+
+#endif // CTRX_POLICY_HPP
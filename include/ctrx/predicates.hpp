@@ -0,0 +1,196 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_PREDICATES_HPP
+#define CTRX_PREDICATES_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#include <cmath>
+
+namespace ctrx
+{
+// Result of a predicate: converts to bool, and describes the offending values if that is false. The values are
+// captured by the description, which is only ever invoked on failure, so passing checks don't pay for it.
+template<typename Describe>
+class [[nodiscard]] predicate_result
+{
+  public:
+    constexpr predicate_result(bool passed, Describe describe) noexcept
+        : m_passed(passed)
+        , m_describe(describe)
+    {
+    }
+
+    // Implicit, as contract conditions must be convertible to bool
+    constexpr operator bool() const noexcept { return m_passed; }
+
+    [[nodiscard]] inline auto describe() const -> std::string { return m_describe(); }
+
+  private:
+    bool     m_passed;
+    Describe m_describe;
+};
+
+namespace detail
+{
+template<typename T>
+[[nodiscard]] inline auto describe_value(T value) -> std::string
+{
+    if constexpr (std::is_same_v<T, bool>)
+        return value ? "true" : "false";
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%g", static_cast<double>(value));
+        return buf;
+    }
+    else if constexpr (std::is_pointer_v<T>)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%p", static_cast<void const*>(value));
+        return buf;
+    }
+    else
+        return std::to_string(value);
+}
+} // namespace detail
+
+// min <= value && value <= max, with a single unsigned comparison for integers. Requires min <= max.
+template<typename T>
+    requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr auto in_range(T value, std::type_identity_t<T> min, std::type_identity_t<T> max) noexcept
+{
+    bool passed;
+    if constexpr (std::is_integral_v<T>)
+    {
+        using unsigned_t = std::make_unsigned_t<decltype(value + 0)>;
+        passed           = static_cast<unsigned_t>(static_cast<unsigned_t>(value) - static_cast<unsigned_t>(min))
+               <= static_cast<unsigned_t>(static_cast<unsigned_t>(max) - static_cast<unsigned_t>(min));
+    }
+    else
+        passed = min <= value && value <= max;
+    return predicate_result{passed,
+                            [=]
+                            {
+                                return "value " + detail::describe_value(value) + " is not in ["
+                                       + detail::describe_value(min) + ", " + detail::describe_value(max) + "]";
+                            }};
+}
+
+// 0 <= index && index < size, with a single unsigned comparison. Requires size >= 0.
+template<std::integral Index, std::integral Size>
+[[nodiscard]] constexpr auto valid_index(Index index, Size size) noexcept
+{
+    using unsigned_t  = std::make_unsigned_t<std::common_type_t<Index, Size, std::size_t>>;
+    bool const passed = static_cast<unsigned_t>(index) < static_cast<unsigned_t>(size);
+    return predicate_result{passed,
+                            [=]
+                            {
+                                return "index " + detail::describe_value(index) + " is out of range for size "
+                                       + detail::describe_value(size);
+                            }};
+}
+
+// Same as above, for the size of a container
+template<std::integral Index, typename Container>
+    requires requires(Container const& c) { std::size(c); }
+[[nodiscard]] constexpr auto valid_index(Index index, Container const& container) noexcept
+{
+    return valid_index(index, std::size(container));
+}
+
+// pointer != nullptr, for raw and smart pointers
+template<typename Pointer>
+    requires requires(Pointer const& p) { p != nullptr; }
+[[nodiscard]] constexpr auto not_null(Pointer const& pointer) noexcept
+{
+    return predicate_result{static_cast<bool>(pointer != nullptr), [] { return std::string("pointer is null"); }};
+}
+
+// Whether pointer is aligned to Alignment bytes, which must be a power of two
+template<std::size_t Alignment, typename T>
+[[nodiscard]] inline auto is_aligned(T const* pointer) noexcept
+{
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+    auto const address = reinterpret_cast<std::uintptr_t>(pointer);
+    return predicate_result{(address & (Alignment - 1)) == 0,
+                            [=]
+                            {
+                                return "address " + detail::describe_value(pointer) + " is not aligned to "
+                                       + std::to_string(Alignment);
+                            }};
+}
+
+// Whether value is neither infinite nor NaN
+template<std::floating_point T>
+[[nodiscard]] constexpr auto finite(T value) noexcept
+{
+    // std::isfinite isn't constexpr before C++23; infinite and NaN values are exactly those for which value - value
+    // is NaN
+    bool const passed = std::is_constant_evaluated() ? value - value == T{0} : std::isfinite(value);
+    return predicate_result{passed, [=] { return "value " + detail::describe_value(value) + " is not finite"; }};
+}
+
+// Whether the ranges [first1, first1 + count1) and [first2, first2 + count2) don't overlap. An empty range only
+// overlaps if it lies strictly within the other one.
+template<typename T, typename U>
+[[nodiscard]] inline auto
+non_overlapping(T const* first1, std::size_t count1, U const* first2, std::size_t count2) noexcept
+{
+    auto const begin1 = reinterpret_cast<std::uintptr_t>(first1);
+    auto const begin2 = reinterpret_cast<std::uintptr_t>(first2);
+    auto const end1   = begin1 + count1 * sizeof(T);
+    auto const end2   = begin2 + count2 * sizeof(U);
+    return predicate_result{end1 <= begin2 || end2 <= begin1,
+                            [=]
+                            {
+                                return "[" + detail::describe_value(first1) + ", +"
+                                       + detail::describe_value(count1) + ") overlaps with ["
+                                       + detail::describe_value(first2) + ", +" + detail::describe_value(count2)
+                                       + ")";
+                            }};
+}
+
+// Same as above, for contiguous ranges, e.g. std::span or std::vector
+template<typename Range1, typename Range2>
+    requires requires(Range1 const& r1, Range2 const& r2) {
+        std::data(r1);
+        std::size(r1);
+        std::data(r2);
+        std::size(r2);
+    }
+[[nodiscard]] inline auto non_overlapping(Range1 const& range1, Range2 const& range2) noexcept
+{
+    return non_overlapping(std::data(range1), std::size(range1), std::data(range2), std::size(range2));
+}
+} // namespace ctrx
+
+#endif // CTRX_PREDICATES_HPP
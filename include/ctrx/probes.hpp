@@ -0,0 +1,97 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef CTRX_PROBES_HPP
+#define CTRX_PROBES_HPP
+
+#include "ctrx/contract_type.hpp"
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/site_id.hpp"
+
+#include <type_traits>
+
+#include <cstdint>
+
+// Probes are emitted in the format of SystemTap's <sys/sdt.h>, which bpftrace, perf and SystemTap read from ELF
+// binaries: a nop at the probe site, and a note in .note.stapsdt with its address and how to read its arguments.
+// Tracers enable a probe by replacing the nop with a breakpoint, so probes that aren't traced cost the nop only.
+#if defined(__GNUC__) && defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__))
+#define CTRX_DETAIL_HAS_PROBES
+#endif
+
+#if defined(CTRX_DETAIL_HAS_PROBES)
+// The note of a probe NAME of the provider ctrx, with an 8 byte and two 4 byte unsigned arguments. The note is put into
+// the section group of the code ("?"), so that it is discarded along with discarded inline functions.
+#define CTRX_DETAIL_PROBE_ASM(NAME)                                                                                    \
+    "990: nop\n"                                                                                                       \
+    ".pushsection .note.stapsdt, \"?\", \"note\"\n"                                                                    \
+    ".balign 4\n"                                                                                                      \
+    ".4byte 992f - 991f, 994f - 993f, 3\n"                                                                             \
+    "991: .asciz \"stapsdt\"\n"                                                                                        \
+    "992: .balign 4\n"                                                                                                 \
+    "993: .8byte 990b\n"                                                                                               \
+    ".8byte _.stapsdt.base\n"                                                                                          \
+    ".8byte 0\n"                                                                                                       \
+    ".asciz \"ctrx\"\n"                                                                                                \
+    ".asciz \"" NAME "\"\n"                                                                                            \
+    ".asciz \"8@%0 4@%1 4@%2\"\n"                                                                                      \
+    "994: .balign 4\n"                                                                                                 \
+    ".popsection\n"                                                                                                    \
+    ".ifndef _.stapsdt.base\n"                                                                                         \
+    ".pushsection .stapsdt.base, \"aG\", \"progbits\", .stapsdt.base, comdat\n"                                        \
+    ".weak _.stapsdt.base\n"                                                                                           \
+    ".hidden _.stapsdt.base\n"                                                                                         \
+    "_.stapsdt.base: .space 1\n"                                                                                       \
+    ".size _.stapsdt.base, 1\n"                                                                                        \
+    ".popsection\n"                                                                                                    \
+    ".endif\n"
+#endif
+
+namespace ctrx::detail
+{
+// The arguments are immediates in the note, so not even a register is set up for them. Immediates are printed as signed
+// numbers, which site ids (63 bit) always fit. Constant evaluations don't fire probes.
+template<site_id_t Site, contract_type Type, unsigned Level>
+CTRX_DETAIL_ALWAYS_INLINE constexpr void probe_check() noexcept
+{
+#if defined(CTRX_DETAIL_HAS_PROBES)
+    if (!std::is_constant_evaluated())
+        asm volatile(CTRX_DETAIL_PROBE_ASM("check")
+                     :
+                     : "n"(Site), "n"(static_cast<unsigned>(Type)), "n"(Level));
+#endif
+}
+
+template<site_id_t Site, contract_type Type, unsigned Level>
+CTRX_DETAIL_ALWAYS_INLINE constexpr void probe_violation() noexcept
+{
+#if defined(CTRX_DETAIL_HAS_PROBES)
+    if (!std::is_constant_evaluated())
+        asm volatile(CTRX_DETAIL_PROBE_ASM("violation")
+                     :
+                     : "n"(Site), "n"(static_cast<unsigned>(Type)), "n"(Level));
+#endif
+}
+} // namespace ctrx::detail
+
+#endif // CTRX_PROBES_HPP
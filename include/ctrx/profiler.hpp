@@ -0,0 +1,394 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_PROFILER_HPP
+#define CTRX_PROFILER_HPP
+
+#include "ctrx/contract_type.hpp"
+#include "ctrx/detail/ticks.hpp"
+#include "ctrx/site_id.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Environment variable naming the file the profile is written to at exit; if it isn't set, nothing is written
+#if !defined(CTRX_CONFIG_PROFILE_OUTPUT_ENV)
+#define CTRX_CONFIG_PROFILE_OUTPUT_ENV "CTRX_PROFILE_OUTPUT"
+#endif
+
+namespace ctrx
+{
+// Cumulative cost of a single contract site, merged over all threads
+struct profile_entry
+{
+    contract_type        type;
+    site_id_t            site_id;
+    char const*          level;
+    char const*          condition;
+    std::source_location source_location;
+    std::uint_least64_t  evaluations;
+    std::uint_least64_t  violations;
+    std::uint_least64_t  ticks;
+};
+
+namespace detail
+{
+// Per-site storage; ids are assigned on first evaluation, 0 means unregistered
+struct profile_site
+{
+    // Id of a site that didn't fit into the registry; it isn't profiled, and registration isn't attempted again
+    static constexpr std::uint_least32_t unregistrable = ~std::uint_least32_t{0};
+
+    std::atomic<std::uint_least32_t> id{0};
+};
+
+// One instance per contract site (Tag is a unique type per site)
+template<typename Tag>
+inline profile_site profile_site_v;
+
+struct profile_counters
+{
+    std::atomic<std::uint_least64_t> evaluations{0};
+    std::atomic<std::uint_least64_t> violations{0};
+    std::atomic<std::uint_least64_t> ticks{0};
+};
+
+// Plain copy of profile_counters
+struct profile_counts
+{
+    std::uint_least64_t evaluations = 0;
+    std::uint_least64_t violations  = 0;
+    std::uint_least64_t ticks       = 0;
+
+    inline auto operator+=(profile_counts const& other) noexcept -> profile_counts&
+    {
+        evaluations += other.evaluations;
+        violations += other.violations;
+        ticks += other.ticks;
+        return *this;
+    }
+};
+
+class thread_profile;
+
+// Global list of sites and threads. Only locked on site registration, thread start/exit and when merging.
+class profile_registry
+{
+  public:
+    static constexpr std::size_t max_sites = 65536;
+
+    [[nodiscard]] static inline auto instance() -> profile_registry&
+    {
+        static profile_registry registry;
+        return registry;
+    }
+
+    inline auto register_site(profile_site& site, profile_entry const& info) -> std::uint_least32_t
+    {
+        std::lock_guard lock{m_mutex};
+        if (auto const id = site.id.load(std::memory_order_relaxed); id != 0)
+            return id;
+
+        // The same site may be seen through different instantiations of the same template
+        std::string const key = std::string(info.source_location.file_name()) + ':'
+                                + std::to_string(info.source_location.line()) + ':'
+                                + std::to_string(info.source_location.column()) + ':' + info.condition;
+        auto [iter, inserted] = m_ids.try_emplace(key, static_cast<std::uint_least32_t>(m_sites.size() + 1));
+        if (inserted)
+        {
+            if (m_sites.size() + 1 >= max_sites)
+            {
+                m_ids.erase(iter);
+                site.id.store(profile_site::unregistrable, std::memory_order_release);
+                return profile_site::unregistrable;
+            }
+            m_sites.push_back(info);
+            m_retired.emplace_back();
+        }
+        site.id.store(iter->second, std::memory_order_release);
+        return iter->second;
+    }
+
+    inline void add_thread(thread_profile* profile)
+    {
+        std::lock_guard lock{m_mutex};
+        m_threads.push_back(profile);
+    }
+
+    inline void remove_thread(thread_profile* profile);
+
+    [[nodiscard]] inline auto merge() -> std::vector<profile_entry>;
+
+    inline void reset();
+
+  private:
+    inline ~profile_registry();
+
+    std::mutex                                           m_mutex;
+    std::vector<profile_entry>                           m_sites;
+    std::unordered_map<std::string, std::uint_least32_t> m_ids;
+    std::vector<thread_profile*>                         m_threads;
+    std::vector<profile_counts>                          m_retired;
+};
+
+// Counters of the sites evaluated by a single thread. Only the owning thread writes, so no atomic RMW is needed.
+class thread_profile
+{
+  public:
+    static constexpr std::size_t chunk_size = 1024;
+    static constexpr std::size_t max_chunks = profile_registry::max_sites / chunk_size;
+
+    inline thread_profile() { profile_registry::instance().add_thread(this); }
+    inline ~thread_profile()
+    {
+        profile_registry::instance().remove_thread(this);
+        for (auto& chunk : m_chunks)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+    thread_profile(thread_profile const&)                    = delete;
+    auto operator=(thread_profile const&) -> thread_profile& = delete;
+
+    inline void add(std::uint_least32_t id, std::uint_least64_t ticks, bool violated)
+    {
+        auto* chunk = m_chunks[id / chunk_size].load(std::memory_order_relaxed);
+        if (chunk == nullptr) [[unlikely]]
+        {
+            chunk = new profile_counters[chunk_size];
+            m_chunks[id / chunk_size].store(chunk, std::memory_order_release);
+        }
+        auto& counters = chunk[id % chunk_size];
+        counters.evaluations.store(counters.evaluations.load(std::memory_order_relaxed) + 1,
+                                   std::memory_order_relaxed);
+        counters.ticks.store(counters.ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+        if (violated)
+            counters.violations.store(counters.violations.load(std::memory_order_relaxed) + 1,
+                                      std::memory_order_relaxed);
+    }
+
+    // Reads the counters of site id; may be called from any thread
+    [[nodiscard]] inline auto read(std::uint_least32_t id) const -> profile_counts
+    {
+        auto const* chunk = m_chunks[id / chunk_size].load(std::memory_order_acquire);
+        if (chunk == nullptr)
+            return {};
+        auto const& counters = chunk[id % chunk_size];
+        return {counters.evaluations.load(std::memory_order_relaxed),
+                counters.violations.load(std::memory_order_relaxed),
+                counters.ticks.load(std::memory_order_relaxed)};
+    }
+
+    inline void reset()
+    {
+        for (auto& chunk : m_chunks)
+        {
+            if (auto* c = chunk.load(std::memory_order_acquire); c != nullptr)
+            {
+                for (std::size_t i = 0; i < chunk_size; ++i)
+                {
+                    c[i].evaluations.store(0, std::memory_order_relaxed);
+                    c[i].violations.store(0, std::memory_order_relaxed);
+                    c[i].ticks.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+  private:
+    std::array<std::atomic<profile_counters*>, max_chunks> m_chunks{};
+};
+
+inline void profile_registry::remove_thread(thread_profile* profile)
+{
+    std::lock_guard lock{m_mutex};
+    for (std::size_t i = 0; i < m_sites.size(); ++i)
+        m_retired[i] += profile->read(static_cast<std::uint_least32_t>(i + 1));
+    std::erase(m_threads, profile);
+}
+
+inline auto profile_registry::merge() -> std::vector<profile_entry>
+{
+    std::lock_guard            lock{m_mutex};
+    std::vector<profile_entry> result = m_sites;
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        auto counts = m_retired[i];
+        for (auto const* thread : m_threads)
+            counts += thread->read(static_cast<std::uint_least32_t>(i + 1));
+        result[i].evaluations = counts.evaluations;
+        result[i].violations  = counts.violations;
+        result[i].ticks       = counts.ticks;
+    }
+    return result;
+}
+
+inline void profile_registry::reset()
+{
+    std::lock_guard lock{m_mutex};
+    std::fill(m_retired.begin(), m_retired.end(), profile_counts{});
+    for (auto* thread : m_threads)
+        thread->reset();
+}
+
+[[nodiscard]] inline auto this_thread_profile() -> thread_profile&
+{
+    thread_local thread_profile profile;
+    return profile;
+}
+
+// Evaluates a contract condition (via fn) and accounts its cost, and whether it failed, to the site identified by Tag
+template<typename Tag, typename Fn>
+inline auto profile_evaluation(contract_type               type,
+                               site_id_t                   site,
+                               char const*                 level,
+                               char const*                 condition,
+                               std::source_location const& sloc,
+                               Fn&&                        fn) -> decltype(fn())
+{
+    auto& profile_site = profile_site_v<Tag>;
+    auto  id           = profile_site.id.load(std::memory_order_acquire);
+    if (id == 0) [[unlikely]]
+        id = profile_registry::instance().register_site(profile_site,
+                                                        profile_entry{type, site, level, condition, sloc, 0, 0, 0});
+    if (id == profile_site::unregistrable) [[unlikely]]
+        return fn();
+
+    auto const start  = read_ticks();
+    auto       result = fn();
+    auto const stop   = read_ticks();
+    this_thread_profile().add(id, stop - start, static_cast<bool>(result));
+    return result;
+}
+
+[[nodiscard]] inline auto to_string(contract_type type) noexcept -> char const*
+{
+    switch (type)
+    {
+    case contract_type::precondition:
+        return "PRECONDITION";
+    case contract_type::postcondition:
+        return "POSTCONDITION";
+    case contract_type::assertion:
+        return "ASSERTION";
+    case contract_type::invariant:
+        return "INVARIANT";
+    }
+    return "UNKNOWN";
+}
+
+// Writes a profile as tab-separated lines of: site id, evaluations, violations, ticks, type, level, file, line,
+// condition. This is the input of ctrx-tier.
+inline void write_profile(std::ostream& out, std::vector<profile_entry> const& entries)
+{
+    out << "# site\tevaluations\tviolations\tticks\ttype\tlevel\tfile\tline\tcondition\n";
+    for (auto const& e : entries)
+    {
+        out << format_site_id(e.site_id).data() << '\t' << e.evaluations << '\t' << e.violations << '\t' << e.ticks
+            << '\t' << to_string(e.type) << '\t' << e.level << '\t' << e.source_location.file_name() << '\t'
+            << e.source_location.line() << '\t' << e.condition << '\n';
+    }
+}
+
+// Records the profile of the whole run, if CTRX_CONFIG_PROFILE_OUTPUT_ENV names a file. The main thread has retired its
+// counters by now, as thread-local objects are destroyed before static ones.
+inline profile_registry::~profile_registry()
+{
+    char const* path = std::getenv(CTRX_CONFIG_PROFILE_OUTPUT_ENV);
+    if (path == nullptr || *path == '\0')
+        return;
+    if (std::ofstream out{path}; out)
+        write_profile(out, merge());
+    else
+        std::fprintf(stderr, "ctrx: cannot write profile to %s\n", path);
+}
+} // namespace detail
+
+// Merges the profiles of all threads and returns the top_n most expensive contract sites, most expensive first
+[[nodiscard]] inline auto profile_report(std::size_t top_n = std::numeric_limits<std::size_t>::max())
+    -> std::vector<profile_entry>
+{
+    auto entries = detail::profile_registry::instance().merge();
+    std::sort(entries.begin(),
+              entries.end(),
+              [](profile_entry const& lhs, profile_entry const& rhs) { return lhs.ticks > rhs.ticks; });
+    if (entries.size() > top_n)
+        entries.resize(top_n);
+    return entries;
+}
+
+// Prints the top_n most expensive contract sites
+inline void print_profile_report(std::FILE* out, std::size_t top_n = 20)
+{
+    std::fprintf(out,
+                 "%14s %12s %10s %10s  %-13s %-7s %s\n",
+                 "ticks",
+                 "evaluations",
+                 "ticks/eval",
+                 "violations",
+                 "type",
+                 "level",
+                 "site");
+    for (auto const& e : profile_report(top_n))
+    {
+        std::fprintf(out,
+                     "%14llu %12llu %10llu %10llu  %-13s %-7s %s:%u: %s\n",
+                     static_cast<unsigned long long>(e.ticks),
+                     static_cast<unsigned long long>(e.evaluations),
+                     static_cast<unsigned long long>(e.evaluations == 0 ? 0 : e.ticks / e.evaluations),
+                     static_cast<unsigned long long>(e.violations),
+                     detail::to_string(e.type),
+                     e.level,
+                     e.source_location.file_name(),
+                     static_cast<unsigned>(e.source_location.line()),
+                     e.condition);
+    }
+}
+
+// Writes the profile of all contract sites evaluated so far, in the format read by ctrx-tier
+inline void write_profile(std::ostream& out)
+{
+    detail::write_profile(out, detail::profile_registry::instance().merge());
+}
+
+// Resets the counters of all sites (in all threads) to zero
+inline void reset_profile()
+{
+    detail::profile_registry::instance().reset();
+}
+} // namespace ctrx
+
+#endif // CTRX_PROFILER_HPP
@@ -0,0 +1,281 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_SHARED_COUNTERS_HPP
+#define CTRX_SHARED_COUNTERS_HPP
+
+#include "ctrx/contract_type.hpp"
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/site_id.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <source_location>
+#include <string>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if __has_include(<sys/mman.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define CTRX_DETAIL_HAS_SHM
+#endif
+
+// Environment variable with the name of the shared memory segment; if it isn't set, the name is /ctrx.<pid>
+#if !defined(CTRX_CONFIG_SHARED_COUNTERS_ENV)
+#define CTRX_CONFIG_SHARED_COUNTERS_ENV "CTRX_SHARED_COUNTERS"
+#endif
+
+// Permissions of the segment; by default, only processes of the same user can read the counters
+#if !defined(CTRX_CONFIG_SHARED_COUNTERS_PERMISSIONS)
+#define CTRX_CONFIG_SHARED_COUNTERS_PERMISSIONS 0600
+#endif
+
+// Number of contract sites the segment has room for; further sites aren't counted
+#if !defined(CTRX_CONFIG_SHARED_COUNTERS_CAPACITY)
+#define CTRX_CONFIG_SHARED_COUNTERS_CAPACITY 4096
+#endif
+
+namespace ctrx
+{
+// Layout of the shared memory segment (version 2): a shared_counters_header, followed by its capacity of
+// shared_counter_slot. Slots are handed out in the order their sites are first executed; a slot is valid once its
+// ready flag is set (with release semantics). All fields are in the byte order of the host, and counters only grow.
+inline constexpr char          shared_counters_magic[8] = {'c', 't', 'r', 'x', 'c', 'n', 't', '\0'};
+inline constexpr std::uint32_t shared_counters_version  = 2;
+
+struct shared_counters_header
+{
+    char                       magic[8];    // shared_counters_magic
+    std::uint32_t              version;     // shared_counters_version
+    std::uint32_t              header_size; // sizeof(shared_counters_header)
+    std::uint32_t              slot_size;   // sizeof(shared_counter_slot)
+    std::uint32_t              capacity;    // number of slots
+    std::atomic<std::uint32_t> used;        // number of slots handed out, ready or not (may exceed capacity)
+    std::uint32_t              pid;         // process that writes the counters
+    std::uint64_t              start_time;  // creation time, in nanoseconds since the Unix epoch
+    char                       reserved[24];
+};
+
+struct shared_counter_slot
+{
+    std::atomic<std::uint32_t> ready; // 1 once the other fields have been written
+    std::uint32_t              line;
+    std::uint64_t              site; // site id, as in the site map
+    std::atomic<std::uint64_t> evaluations;
+    std::atomic<std::uint64_t> violations;
+    std::uint8_t               type; // contract_type
+    char                       reserved[7];
+    char                       level[16];    // "DEFAULT", "AUDIT", "O_N", ...
+    char                       location[72]; // "<file name>:<line>: <condition>", truncated
+};
+
+static_assert(sizeof(shared_counters_header) == 64);
+static_assert(sizeof(shared_counter_slot) == 128);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+              "shared counters need lock-free atomics");
+
+namespace detail
+{
+// The segment of the process, created when the first contract site is executed. A segment is never shared: if the
+// configured name exists, e.g. as several workers were started with the same environment, the pid is appended to it.
+// Its name is unlinked at exit, but it stays mapped, as contracts may still be checked by static destructors. Sites
+// that find no room, or no segment, are counted in a slot of the process only.
+class shared_counters
+{
+  public:
+    [[nodiscard]] static inline auto instance() -> shared_counters&
+    {
+        static shared_counters counters;
+        return counters;
+    }
+
+    shared_counters(shared_counters const&)                    = delete;
+    auto operator=(shared_counters const&) -> shared_counters& = delete;
+
+    [[nodiscard]] inline auto name() const -> std::string const& { return m_name; }
+
+    // Hands out the slot of a site, unless another thread has done so already
+    inline auto register_site(std::atomic<shared_counter_slot*>& site_slot,
+                              contract_type                      type,
+                              site_id_t                          site,
+                              char const*                        level,
+                              char const*                        condition,
+                              std::source_location const&        sloc) -> shared_counter_slot*
+    {
+        std::lock_guard lock{m_mutex};
+        if (auto* slot = site_slot.load(std::memory_order_acquire); slot != nullptr)
+            return slot;
+        shared_counter_slot* slot = &m_fallback;
+        if (m_header != nullptr)
+        {
+            auto const index = m_header->used.fetch_add(1, std::memory_order_relaxed);
+            if (index < m_header->capacity)
+            {
+                slot = reinterpret_cast<shared_counter_slot*>(m_header + 1) + index;
+                describe(*slot, type, site, level, condition, sloc);
+                slot->ready.store(1, std::memory_order_release);
+            }
+        }
+        site_slot.store(slot, std::memory_order_release);
+        return slot;
+    }
+
+  private:
+    inline shared_counters()
+    {
+#if defined(CTRX_DETAIL_HAS_SHM)
+        std::string const pid        = std::to_string(::getpid());
+        char const*       configured = std::getenv(CTRX_CONFIG_SHARED_COUNTERS_ENV);
+        bool const        named      = configured != nullptr && *configured != '\0';
+        m_name                       = named ? configured : "/ctrx." + pid;
+
+        // Created exclusively, so that no other process's counters are truncated, or unlinked at exit
+        int const permissions = CTRX_CONFIG_SHARED_COUNTERS_PERMISSIONS;
+        int       fd          = ::shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, permissions);
+        if (fd < 0 && errno == EEXIST && named)
+        {
+            std::fprintf(stderr,
+                         "ctrx: shared counters %s exist, using %s.%s\n",
+                         m_name.c_str(),
+                         m_name.c_str(),
+                         pid.c_str());
+            m_name += "." + pid;
+            fd = ::shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, permissions);
+        }
+        if (fd < 0)
+        {
+            std::fprintf(stderr, "ctrx: cannot create shared counters %s: %s\n", m_name.c_str(), std::strerror(errno));
+            m_name.clear();
+            return;
+        }
+
+        std::size_t const size = sizeof(shared_counters_header)
+                                 + std::size_t{CTRX_CONFIG_SHARED_COUNTERS_CAPACITY} * sizeof(shared_counter_slot);
+        void* memory = ::ftruncate(fd, static_cast<off_t>(size)) == 0
+                           ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                           : MAP_FAILED;
+        ::close(fd);
+        if (memory == MAP_FAILED)
+        {
+            std::fprintf(stderr, "ctrx: cannot map shared counters %s\n", m_name.c_str());
+            ::shm_unlink(m_name.c_str());
+            m_name.clear();
+            return;
+        }
+
+        // The memory is zeroed, so that the counters and ready flags are, too
+        auto* header = new (memory) shared_counters_header{};
+        std::memcpy(header->magic, shared_counters_magic, sizeof(header->magic));
+        header->version     = shared_counters_version;
+        header->header_size = sizeof(shared_counters_header);
+        header->slot_size   = sizeof(shared_counter_slot);
+        header->capacity    = CTRX_CONFIG_SHARED_COUNTERS_CAPACITY;
+        header->pid         = static_cast<std::uint32_t>(::getpid());
+        header->start_time  = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+                .count());
+        auto* slots = reinterpret_cast<shared_counter_slot*>(header + 1);
+        for (std::size_t i = 0; i < CTRX_CONFIG_SHARED_COUNTERS_CAPACITY; ++i)
+            new (slots + i) shared_counter_slot{};
+        m_header = header;
+#endif
+    }
+
+    inline ~shared_counters()
+    {
+#if defined(CTRX_DETAIL_HAS_SHM)
+        if (m_header != nullptr)
+            ::shm_unlink(m_name.c_str());
+#endif
+    }
+
+    static inline void describe(shared_counter_slot&        slot,
+                                contract_type               type,
+                                site_id_t                   site,
+                                char const*                 level,
+                                char const*                 condition,
+                                std::source_location const& sloc)
+    {
+        slot.site = site;
+        slot.line = static_cast<std::uint32_t>(sloc.line());
+        slot.type = static_cast<std::uint8_t>(type);
+        std::snprintf(slot.level, sizeof(slot.level), "%s", level);
+        std::snprintf(slot.location,
+                      sizeof(slot.location),
+                      "%s:%u: %s",
+                      basename(sloc.file_name()),
+                      static_cast<unsigned>(sloc.line()),
+                      condition);
+    }
+
+    std::mutex              m_mutex;
+    std::string             m_name;
+    shared_counters_header* m_header = nullptr;
+    shared_counter_slot     m_fallback{};
+};
+
+template<typename Tag>
+inline std::atomic<shared_counter_slot*> shared_counter_slot_v{nullptr};
+
+// Evaluates a contract condition (via fn) and counts the evaluation, and whether it failed, in the slot of the site
+// identified by Tag. The counters are incremented with relaxed atomic operations, without any system call.
+template<typename Tag, typename Fn>
+inline auto count_evaluation(contract_type               type,
+                             site_id_t                   site,
+                             char const*                 level,
+                             char const*                 condition,
+                             std::source_location const& sloc,
+                             Fn&&                        fn) -> decltype(fn())
+{
+    auto* slot = shared_counter_slot_v<Tag>.load(std::memory_order_acquire);
+    if (slot == nullptr) [[unlikely]]
+    {
+        auto& counters = shared_counters::instance();
+        slot           = counters.register_site(shared_counter_slot_v<Tag>, type, site, level, condition, sloc);
+    }
+
+    auto result = fn();
+    slot->evaluations.fetch_add(1, std::memory_order_relaxed);
+    if (result)
+        slot->violations.fetch_add(1, std::memory_order_relaxed);
+    return result;
+}
+} // namespace detail
+
+// Name of the shared memory segment with the counters of this process, or an empty string if there is none
+[[nodiscard]] inline auto shared_counters_name() -> std::string
+{
+    return detail::shared_counters::instance().name();
+}
+} // namespace ctrx
+
+#endif // CTRX_SHARED_COUNTERS_HPP
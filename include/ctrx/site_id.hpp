@@ -0,0 +1,129 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_SITE_ID_HPP
+#define CTRX_SITE_ID_HPP
+
+#include <array>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ctrx
+{
+// Site ids are 63 bit hashes, which are never 0 (so 0 can mean "no site") and are positive as signed 64 bit numbers
+// (as which SDT probe arguments and CMake read them)
+using site_id_t = std::uint_least64_t;
+
+namespace detail
+{
+// 64 bit FNV-1a, used to derive contract site ids
+inline constexpr std::uint_least64_t fnv1a_offset = 14695981039346656037u;
+inline constexpr std::uint_least64_t fnv1a_prime  = 1099511628211u;
+
+[[nodiscard]] constexpr auto fnv1a(std::uint_least64_t hash, char const* str) noexcept -> std::uint_least64_t
+{
+    for (; *str != '\0'; ++str)
+        hash = ((hash ^ static_cast<unsigned char>(*str)) * fnv1a_prime) & 0xffffffffffffffffu;
+    return hash;
+}
+
+[[nodiscard]] constexpr auto fnv1a(std::uint_least64_t hash, std::uint_least64_t value) noexcept
+    -> std::uint_least64_t
+{
+    char        digits[21]{};
+    std::size_t count = 20;
+    do
+    {
+        digits[--count] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return fnv1a(hash, digits + count);
+}
+
+[[nodiscard]] constexpr auto basename(char const* path) noexcept -> char const*
+{
+    char const* name = path;
+    for (; *path != '\0'; ++path)
+        if (*path == '/' || *path == '\\')
+            name = path + 1;
+    return name;
+}
+
+// Hashes "<file name>:<line>:<contract text>", followed by ":<index>" for the conditions of batched contracts. The
+// text is the macro arguments exactly as stringized by the preprocessor, which the site map generator reproduces.
+[[nodiscard]] constexpr auto hash_site(char const*         file,
+                                       std::uint_least64_t line,
+                                       char const*          text,
+                                       unsigned             index) noexcept -> site_id_t
+{
+    auto hash = fnv1a(fnv1a_offset, basename(file));
+    hash      = fnv1a(hash, ":");
+    hash      = fnv1a(hash, line);
+    hash      = fnv1a(hash, ":");
+    hash      = fnv1a(hash, text);
+    if (index != 0)
+    {
+        hash = fnv1a(hash, ":");
+        hash = fnv1a(hash, index);
+    }
+    hash &= 0x7fffffffffffffffu;
+    return hash != 0 ? hash : 1;
+}
+
+// Forces the site id to be computed at compile time, so none of its inputs end up in the binary
+[[nodiscard]] consteval auto site_id(char const*         file,
+                                     std::uint_least64_t line,
+                                     char const*          text,
+                                     unsigned             index) noexcept -> site_id_t
+{
+    return hash_site(file, line, text, index);
+}
+} // namespace detail
+
+// Number of hexadecimal digits of a formatted site id
+inline constexpr std::size_t site_id_digits = 16;
+
+// Formats a site id as zero-padded hexadecimal number, e.g. "0x1234abcd5678ef90"
+[[nodiscard]] constexpr auto format_site_id(site_id_t id) noexcept -> std::array<char, site_id_digits + 3>
+{
+    std::array<char, site_id_digits + 3> result{'0', 'x'};
+    for (std::size_t i = 0; i < site_id_digits; ++i)
+        result[site_id_digits + 1 - i] = "0123456789abcdef"[(id >> (4 * i)) & 0xfu];
+    result[site_id_digits + 2] = '\0';
+    return result;
+}
+
+namespace detail
+{
+// Message reported in place of the contract text when strings are stripped, e.g. "site 0x1234abcd5678ef90"
+[[nodiscard]] inline auto site_message(site_id_t id) -> std::string
+{
+    return std::string("site ") + format_site_id(id).data();
+}
+} // namespace detail
+} // namespace ctrx
+
+#endif // CTRX_SITE_ID_HPP
@@ -0,0 +1,224 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_SITE_MAP_HPP
+#define CTRX_SITE_MAP_HPP
+
+#include "ctrx/site_id.hpp"
+
+#include <fstream>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ctrx
+{
+// Maps the site ids reported by builds with stripped strings (CTRX_CONFIG_STRIP_STRINGS) back to their contracts. The
+// map is generated by ctrx-site-map as tab-separated lines of: id, file, line, type, level, condition, message.
+class site_map
+{
+  public:
+    struct entry
+    {
+        site_id_t     id;
+        std::string   file;
+        std::uint32_t line;
+        std::string   type;
+        std::string   level;
+        std::string   condition;
+        std::string   message;
+    };
+
+    // Parses a site map; returns nullopt if it is malformed, which includes two different contracts with the same id
+    [[nodiscard]] static inline auto parse(std::istream& in) -> std::optional<site_map>
+    {
+        site_map result;
+        for (std::string line; std::getline(in, line);)
+        {
+            if (line.empty() || line.front() == '#')
+                continue;
+            auto const fields = split(line);
+            if (fields.size() != 7)
+                return std::nullopt;
+            auto const id = parse_number(fields[0], 16);
+            auto const ln = parse_number(fields[2], 10);
+            if (!id || !ln)
+                return std::nullopt;
+            entry e{static_cast<site_id_t>(*id),
+                    fields[1],
+                    static_cast<std::uint32_t>(*ln),
+                    fields[3],
+                    fields[4],
+                    fields[5],
+                    fields[6]};
+            auto const [it, inserted] = result.m_entries.try_emplace(e.id, e);
+            if (!inserted && !same_contract(it->second, e))
+                return std::nullopt;
+        }
+        return result;
+    }
+
+    // Reads a site map from a file; returns nullopt if it can't be read or is malformed
+    [[nodiscard]] static inline auto load(std::string const& path) -> std::optional<site_map>
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return std::nullopt;
+        return parse(file);
+    }
+
+    // Writes entries in the format understood by parse()
+    static inline void write(std::ostream& out, std::vector<entry> const& entries)
+    {
+        out << "# ctrx site map: id, file, line, type, level, condition, message\n";
+        for (auto const& e : entries)
+        {
+            out << format_site_id(e.id).data() << '\t' << escape(e.file) << '\t' << e.line << '\t' << escape(e.type)
+                << '\t' << escape(e.level) << '\t' << escape(e.condition) << '\t' << escape(e.message) << '\n';
+        }
+    }
+
+    // Whether two entries describe the same contract, e.g. of a header that was scanned along with several sources
+    [[nodiscard]] static inline auto same_contract(entry const& lhs, entry const& rhs) noexcept -> bool
+    {
+        return lhs.file == rhs.file && lhs.line == rhs.line && lhs.condition == rhs.condition;
+    }
+
+    [[nodiscard]] inline auto size() const noexcept -> std::size_t { return m_entries.size(); }
+    [[nodiscard]] inline auto empty() const noexcept -> bool { return m_entries.empty(); }
+
+    // Returns the contract with the given site id, or nullptr if it's unknown
+    [[nodiscard]] inline auto find(site_id_t id) const noexcept -> entry const*
+    {
+        auto const it = m_entries.find(id);
+        return it != m_entries.end() ? &it->second : nullptr;
+    }
+
+    // Describes a contract like reports of builds without stripped strings do, e.g. "a.cpp:42 PRECONDITION failure: x"
+    [[nodiscard]] static inline auto describe(entry const& e) -> std::string
+    {
+        std::string result = e.file + ":" + std::to_string(e.line) + " " + e.type + " failure: " + e.condition;
+        if (!e.message.empty())
+            result += " (" + e.message + ")";
+        return result;
+    }
+
+    // Replaces every known "site 0x<16 hex digits>" within text by the description of that contract
+    [[nodiscard]] inline auto rehydrate(std::string_view text) const -> std::string
+    {
+        constexpr std::string_view prefix = "site 0x";
+        constexpr std::size_t      digits = site_id_digits;
+
+        std::string result;
+        std::size_t pos = 0;
+        while (pos < text.size())
+        {
+            auto const found = text.find(prefix, pos);
+            if (found == std::string_view::npos || found + prefix.size() + digits > text.size())
+                break;
+            auto const  hex = text.substr(found + prefix.size(), digits);
+            auto const  id  = parse_number(std::string(hex), 16);
+            auto const* e   = id ? find(static_cast<site_id_t>(*id)) : nullptr;
+            result.append(text.substr(pos, found - pos));
+            if (e != nullptr)
+                result += describe(*e);
+            else
+                result.append(text.substr(found, prefix.size() + digits));
+            pos = found + prefix.size() + digits;
+        }
+        result.append(text.substr(pos));
+        return result;
+    }
+
+  private:
+    static inline auto escape(std::string_view str) -> std::string
+    {
+        std::string result;
+        for (char c : str)
+        {
+            switch (c)
+            {
+            case '\\': result += "\\\\"; break;
+            case '\t': result += "\\t"; break;
+            case '\n': result += "\\n"; break;
+            default: result += c;
+            }
+        }
+        return result;
+    }
+
+    static inline auto split(std::string_view line) -> std::vector<std::string>
+    {
+        std::vector<std::string> fields(1);
+        for (std::size_t i = 0; i < line.size(); ++i)
+        {
+            if (line[i] == '\t')
+                fields.emplace_back();
+            else if (line[i] == '\\' && i + 1 < line.size())
+            {
+                char const c = line[++i];
+                fields.back() += c == 't' ? '\t' : c == 'n' ? '\n' : c;
+            }
+            else if (line[i] != '\r')
+                fields.back() += line[i];
+        }
+        return fields;
+    }
+
+    static inline auto parse_number(std::string const& str, int base) -> std::optional<std::uint_least64_t>
+    {
+        std::string_view digits = str;
+        if (base == 16 && digits.starts_with("0x"))
+            digits.remove_prefix(2);
+        if (digits.empty())
+            return std::nullopt;
+        std::uint_least64_t value = 0;
+        for (char c : digits)
+        {
+            int digit = -1;
+            if (c >= '0' && c <= '9')
+                digit = c - '0';
+            else if (base == 16 && c >= 'a' && c <= 'f')
+                digit = c - 'a' + 10;
+            else if (base == 16 && c >= 'A' && c <= 'F')
+                digit = c - 'A' + 10;
+            if (digit < 0 || digit >= base)
+                return std::nullopt;
+            value = value * static_cast<std::uint_least64_t>(base) + static_cast<std::uint_least64_t>(digit);
+        }
+        return value;
+    }
+
+    std::unordered_map<site_id_t, entry> m_entries;
+};
+} // namespace ctrx
+
+#endif // CTRX_SITE_MAP_HPP
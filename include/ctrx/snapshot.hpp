@@ -0,0 +1,229 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_SNAPSHOT_HPP
+#define CTRX_SNAPSHOT_HPP
+
+#include "ctrx/contracts.hpp"
+#include "ctrx/cost.hpp"
+#include "ctrx/detail/crc32c.hpp"
+#include "ctrx/predicates.hpp"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <ranges>
+#include <string>
+#include <type_traits>
+
+#include <cstdint>
+#include <cstdio>
+
+namespace ctrx
+{
+// Buffers whose bytes can be checksummed: contiguous ranges of trivially copyable elements (arrays, std::vector,
+// std::span, ...), or trivially copyable objects. Padding bytes are part of the checksum.
+template<typename Buffer>
+concept snapshottable =
+    (std::ranges::contiguous_range<Buffer const> && std::ranges::sized_range<Buffer const>
+     && std::is_trivially_copyable_v<std::ranges::range_value_t<Buffer const>>)
+    || (!std::ranges::range<Buffer const> && std::is_trivially_copyable_v<Buffer>);
+
+namespace detail
+{
+// CRC-32C of the bytes of a buffer. Constant evaluation can't inspect the bytes of an object through a pointer, so it
+// takes them one element at a time; this requires the elements not to contain pointers.
+template<snapshottable Buffer>
+[[nodiscard]] constexpr auto checksum_of(Buffer const& buffer) noexcept -> std::uint32_t
+{
+    if (std::is_constant_evaluated())
+    {
+        std::uint32_t crc    = ~std::uint32_t{0};
+        auto const    update = [&crc]<typename T>(T const& value)
+        {
+            for (auto const byte : std::bit_cast<std::array<unsigned char, sizeof(T)>>(value))
+                crc = crc32c_byte(crc, byte);
+        };
+        if constexpr (std::ranges::range<Buffer const>)
+            for (auto const& element : buffer)
+                update(element);
+        else
+            update(buffer);
+        return ~crc;
+    }
+    if constexpr (std::ranges::range<Buffer const>)
+        return crc32c(std::ranges::data(buffer), std::ranges::size(buffer) * sizeof(*std::ranges::data(buffer)));
+    else
+        return crc32c(&buffer, sizeof(buffer));
+}
+
+[[nodiscard]] inline auto describe_checksum(std::uint32_t checksum) -> std::string
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "0x%08x", static_cast<unsigned>(checksum));
+    return buf;
+}
+} // namespace detail
+
+// Result of snapshot::unchanged. Its check was sampled along with the snapshot, and costs nothing if the snapshot
+// wasn't taken, so adaptive checking doesn't sample it a second time.
+template<typename Describe>
+class [[nodiscard]] snapshot_result : public predicate_result<Describe>
+{
+  public:
+    using sampled_at_capture = void;
+
+    using predicate_result<Describe>::predicate_result;
+};
+
+// Checksum of a buffer at one point of the program, to verify later that it hasn't changed since. A default
+// constructed snapshot hasn't been taken, and any buffer counts as unchanged against it.
+class snapshot
+{
+  public:
+    constexpr snapshot() noexcept = default;
+    template<snapshottable Buffer>
+    constexpr explicit snapshot(Buffer const& buffer) noexcept
+        : m_taken(true)
+        , m_checksum(detail::checksum_of(buffer))
+    {
+    }
+
+    [[nodiscard]] constexpr auto taken() const noexcept -> bool { return m_taken; }
+    [[nodiscard]] constexpr auto checksum() const noexcept -> std::uint32_t { return m_checksum; }
+
+    // Whether buffer has the checksum of the snapshot. The checksum is only computed if the snapshot was taken.
+    template<snapshottable Buffer>
+    [[nodiscard]] constexpr auto unchanged(Buffer const& buffer) const noexcept
+    {
+        std::uint32_t const current  = m_taken ? detail::checksum_of(buffer) : m_checksum;
+        auto const          describe = [current, expected = m_checksum]
+        {
+            return "checksum " + detail::describe_checksum(current) + " differs from "
+                   + detail::describe_checksum(expected) + " at the snapshot";
+        };
+        return snapshot_result<decltype(describe)>{current == m_checksum, describe};
+    }
+
+  private:
+    bool          m_taken    = false;
+    std::uint32_t m_checksum = 0;
+};
+} // namespace ctrx
+
+// ------------------------------------------------------
+// Implementation of buffer snapshots
+// ------------------------------------------------------
+
+// Declares the snapshot of BUFFER that CTRX_ASSERT_UNCHANGED checks, along with the site id of the pair. The snapshot
+// is only taken if its level is affordable at runtime for that site (and allowed by the policy), and if adaptive
+// checking samples it. CTRX_ASSERT_UNCHANGED then checks under the same site id, and needn't know about either
+// decision: a snapshot that wasn't taken passes.
+#define CTRX_DETAIL_TAKE_SNAPSHOT(TYPE, LEVEL, SITE, MSG, BUFFER)                                                      \
+    [[maybe_unused]] constexpr ::ctrx::site_id_t CTRX_DETAIL_CONCAT2(ctrx_snapshot_site_, BUFFER) = SITE;              \
+    ::ctrx::snapshot const CTRX_DETAIL_CONCAT2(ctrx_snapshot_, BUFFER) =                                               \
+        CTRX_DETAIL_AFFORDABLE(TYPE, LEVEL, SITE) ? CTRX_DETAIL_SAMPLED_SNAPSHOT(TYPE, LEVEL, BUFFER)                  \
+                                                  : ::ctrx::snapshot{}
+// Takes the snapshot with the evaluation probability of its site if adaptive checking is enabled (see
+// CTRX_DETAIL_EVAL_SAMPLED), so that the time taken by the checksum is accounted for there
+#if defined(CTRX_CONFIG_ADAPTIVE)
+#define CTRX_DETAIL_SAMPLED_SNAPSHOT(TYPE, LEVEL, BUFFER)                                                              \
+    [&]() -> ::ctrx::snapshot                                                                                          \
+    {                                                                                                                  \
+        if constexpr (CTRX_DETAIL_TIER(LEVEL) <= 1)                                                                    \
+            return ::ctrx::snapshot{BUFFER};                                                                           \
+        else                                                                                                           \
+        {                                                                                                              \
+            if (std::is_constant_evaluated())                                                                          \
+                return ::ctrx::snapshot{BUFFER};                                                                       \
+            return ::ctrx::detail::adaptive_evaluation<decltype([] {})>(CTRX_DETAIL_ENUM_TYPE(TYPE),                   \
+                                                                        CTRX_DETAIL_STRINGIFY2(LEVEL),                 \
+                                                                        #BUFFER,                                       \
+                                                                        std::source_location::current(),               \
+                                                                        [&] { return ::ctrx::snapshot{BUFFER}; });     \
+        }                                                                                                              \
+    }()
+#else
+#define CTRX_DETAIL_SAMPLED_SNAPSHOT(TYPE, LEVEL, BUFFER) ::ctrx::snapshot{BUFFER}
+#endif
+// Runs the regular checker of TYPE on the snapshot of BUFFER, under the site id of the snapshot
+#define CTRX_DETAIL_CHECK_UNCHANGED(TYPE, LEVEL, SITE, MSG, BUFFER)                                                    \
+    CTRX_DETAIL_GET_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(TYPE))                                                      \
+    (TYPE,                                                                                                             \
+     LEVEL,                                                                                                            \
+     CTRX_DETAIL_CONCAT2(ctrx_snapshot_site_, BUFFER),                                                                 \
+     MSG,                                                                                                              \
+     CTRX_DETAIL_CONCAT2(ctrx_snapshot_, BUFFER).unchanged(BUFFER))
+
+// Snapshots are only taken where they are checked. Where they aren't, neither is declared, and both are replaced by
+// CTRX_DETAIL_CHECK_MODE_OFF on the buffer alone. This includes ASSUME mode, as the check can't be assumed, and
+// ASSERT mode with NDEBUG.
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_OFF CTRX_DETAIL_CHECK_MODE_OFF
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_ASSUME CTRX_DETAIL_CHECK_MODE_OFF
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_THROW CTRX_DETAIL_TAKE_SNAPSHOT
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_TERMINATE CTRX_DETAIL_TAKE_SNAPSHOT
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_HANDLER CTRX_DETAIL_TAKE_SNAPSHOT
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_FUZZ CTRX_DETAIL_TAKE_SNAPSHOT
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_OFF CTRX_DETAIL_CHECK_MODE_OFF
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_ASSUME CTRX_DETAIL_CHECK_MODE_OFF
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_THROW CTRX_DETAIL_CHECK_UNCHANGED
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_TERMINATE CTRX_DETAIL_CHECK_UNCHANGED
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_HANDLER CTRX_DETAIL_CHECK_UNCHANGED
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_FUZZ CTRX_DETAIL_CHECK_UNCHANGED
+#if defined(NDEBUG)
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_ASSERT CTRX_DETAIL_CHECK_MODE_OFF
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_ASSERT CTRX_DETAIL_CHECK_MODE_OFF
+#else
+#define CTRX_DETAIL_TAKE_SNAPSHOT_MODE_ASSERT CTRX_DETAIL_TAKE_SNAPSHOT
+#define CTRX_DETAIL_CHECK_UNCHANGED_MODE_ASSERT CTRX_DETAIL_CHECK_UNCHANGED
+#endif
+
+#define CTRX_DETAIL_GET_SNAPSHOT_CHECKER(MODE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_TAKE_SNAPSHOT_MODE_, MODE)
+#define CTRX_DETAIL_GET_UNCHANGED_CHECKER(MODE) CTRX_DETAIL_CONCAT2(CTRX_DETAIL_CHECK_UNCHANGED_MODE_, MODE)
+
+#define CTRX_DETAIL_SNAPSHOT_3(SITE, BUFFER, LEVEL)                                                                    \
+    CTRX_DETAIL_CHECK_LEVEL(CTRX_DETAIL_GET_SNAPSHOT_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(ASSERTION)),               \
+                            ASSERTION,                                                                                 \
+                            CTRX_DETAIL_LEVEL(LEVEL))                                                                  \
+    (ASSERTION, CTRX_DETAIL_LEVEL(LEVEL), SITE, "", BUFFER)
+#define CTRX_DETAIL_SNAPSHOT_2(SITE, BUFFER) CTRX_DETAIL_SNAPSHOT_3(SITE, BUFFER, DEFAULT)
+
+#define CTRX_DETAIL_ASSERT_UNCHANGED_3(BUFFER, LEVEL)                                                                  \
+    CTRX_DETAIL_CHECK_LEVEL(CTRX_DETAIL_GET_UNCHANGED_CHECKER(CTRX_DETAIL_GET_MODE_FROM_TYPE(ASSERTION)),              \
+                            ASSERTION,                                                                                 \
+                            CTRX_DETAIL_LEVEL(LEVEL))                                                                  \
+    (ASSERTION, CTRX_DETAIL_LEVEL(LEVEL), 0, CTRX_DETAIL_FORMAT_MSG(#BUFFER " changed since its snapshot"), BUFFER)
+#define CTRX_DETAIL_ASSERT_UNCHANGED_2(BUFFER) CTRX_DETAIL_ASSERT_UNCHANGED_3(BUFFER, DEFAULT)
+
+// Takes a snapshot of the buffer named by the (unqualified) identifier BUFFER, with an optional level. The snapshot is
+// a local variable, so CTRX_ASSERT_UNCHANGED must follow within the same scope. The pair is a single contract site,
+// identified by the snapshot: its site id is the one that is reported, overridden, sampled and profiled.
+#define CTRX_SNAPSHOT(...)                                                                                             \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_SNAPSHOT_, CTRX_DETAIL_OVERLOAD(__VA_ARGS__))                                      \
+    (CTRX_DETAIL_SITE_ID(#__VA_ARGS__, 0), __VA_ARGS__)
+// Asserts that BUFFER has the checksum of its snapshot, with the same level
+#define CTRX_ASSERT_UNCHANGED(...)                                                                                     \
+    CTRX_DETAIL_CONCAT2(CTRX_DETAIL_ASSERT_UNCHANGED_, CTRX_DETAIL_OVERLOAD(__VA_ARGS__))(__VA_ARGS__)
+
+#endif // CTRX_SNAPSHOT_HPP
@@ -0,0 +1,177 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef CTRX_STACKTRACE_HPP
+#define CTRX_STACKTRACE_HPP
+
+#include "ctrx/detail/attributes.hpp"
+
+#include <array>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#if __has_include(<unwind.h>)
+#include <unwind.h>
+#define CTRX_DETAIL_HAS_UNWIND
+#endif
+#if __has_include(<dlfcn.h>) && __has_include(<link.h>) && __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <link.h>
+#define CTRX_DETAIL_HAS_DLADDR
+#endif
+
+// Maximum number of return addresses captured per contract violation (at most raw_stacktrace::capacity)
+#if !defined(CTRX_CONFIG_STACKTRACE_DEPTH)
+#define CTRX_CONFIG_STACKTRACE_DEPTH 32
+#endif
+
+namespace ctrx
+{
+// Raw return addresses of a call stack. Capturing is cheap; symbolization only happens on request.
+class raw_stacktrace
+{
+  public:
+    using frame_type = std::uintptr_t;
+
+    // Fixed, so that the layout doesn't depend on CTRX_CONFIG_STACKTRACE_DEPTH (violations carrying traces are thrown
+    // across libraries that may configure it differently)
+    static constexpr std::size_t capacity = 64;
+    static_assert(CTRX_CONFIG_STACKTRACE_DEPTH <= capacity, "CTRX_CONFIG_STACKTRACE_DEPTH exceeds the capacity");
+
+    // Captures up to depth frames of the call stack of the caller (the function calling capture() is the first frame).
+    // The depth is a parameter, so that the definition doesn't depend on CTRX_CONFIG_STACKTRACE_DEPTH either.
+    [[nodiscard]] CTRX_DETAIL_NOINLINE static inline auto
+    capture(std::size_t skip = 0, std::size_t depth = CTRX_CONFIG_STACKTRACE_DEPTH) noexcept -> raw_stacktrace
+    {
+        raw_stacktrace trace;
+#if defined(CTRX_DETAIL_HAS_UNWIND)
+        struct state_t
+        {
+            raw_stacktrace* trace;
+            std::size_t     skip;
+            std::size_t     depth;
+        } state{&trace, skip + 1, depth < capacity ? depth : capacity};
+        _Unwind_Backtrace(
+            [](_Unwind_Context* ctx, void* arg) -> _Unwind_Reason_Code
+            {
+                auto& s = *static_cast<state_t*>(arg);
+                if (s.skip > 0)
+                {
+                    --s.skip;
+                    return _URC_NO_REASON;
+                }
+                if (s.trace->m_size == s.depth)
+                    return _URC_END_OF_STACK;
+                frame_type const ip = _Unwind_GetIP(ctx);
+                if (ip == 0)
+                    return _URC_END_OF_STACK;
+                s.trace->m_frames[s.trace->m_size++] = ip;
+                return _URC_NO_REASON;
+            },
+            &state);
+#else
+        (void)skip;
+        (void)depth;
+#endif
+        return trace;
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return m_size; }
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_size == 0; }
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const noexcept -> frame_type { return m_frames[i]; }
+    [[nodiscard]] constexpr auto begin() const noexcept -> frame_type const* { return m_frames.data(); }
+    [[nodiscard]] constexpr auto end() const noexcept -> frame_type const* { return m_frames.data() + m_size; }
+
+    // Symbolizes the captured frames, one line per frame: "#<index> 0x<address> <module>+0x<offset> (<symbol>)"
+    [[nodiscard]] inline auto to_string() const -> std::string
+    {
+        std::string result;
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            char buf[64];
+            std::snprintf(buf,
+                          sizeof(buf),
+                          "#%zu 0x%llx",
+                          i,
+                          static_cast<unsigned long long>(m_frames[i]));
+            result += buf;
+#if defined(CTRX_DETAIL_HAS_DLADDR)
+            // Return addresses point past the call instruction; look up the call itself
+            Dl_info info{};
+            if (::dladdr(reinterpret_cast<void*>(m_frames[i] - 1), &info) != 0 && info.dli_fname != nullptr)
+            {
+                std::snprintf(buf,
+                              sizeof(buf),
+                              "+0x%llx",
+                              static_cast<unsigned long long>(m_frames[i]
+                                                              - reinterpret_cast<frame_type>(info.dli_fbase)));
+                result += std::string(" ") + info.dli_fname + buf;
+                if (info.dli_sname != nullptr)
+                {
+                    int   status    = 0;
+                    char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                    result += std::string(" (") + (status == 0 ? demangled : info.dli_sname) + ")";
+                    std::free(demangled);
+                }
+            }
+#endif
+            result += '\n';
+        }
+        return result;
+    }
+
+  private:
+    std::array<frame_type, capacity> m_frames{};
+    std::size_t                      m_size = 0;
+};
+
+// Returns the load addresses of all loaded modules, one line per module: "0x<address> <path>". Together with a
+// raw_stacktrace, this allows symbolizing offline (e.g. using addr2line).
+[[nodiscard]] inline auto load_map() -> std::string
+{
+    std::string result;
+#if defined(CTRX_DETAIL_HAS_DLADDR)
+    ::dl_iterate_phdr(
+        [](dl_phdr_info* info, std::size_t, void* arg) -> int
+        {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "0x%llx ", static_cast<unsigned long long>(info->dlpi_addr));
+            auto& result = *static_cast<std::string*>(arg);
+            result += buf;
+            result += info->dlpi_name;
+            result += '\n';
+            return 0;
+        },
+        &result);
+#endif
+    return result;
+}
+} // namespace ctrx
+
+#endif // CTRX_STACKTRACE_HPP
@@ -0,0 +1,158 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef CTRX_VALIDATED_HPP
+#define CTRX_VALIDATED_HPP
+
+#include "ctrx/contracts.hpp"
+#include "ctrx/detail/attributes.hpp"
+#include "ctrx/ghost.hpp"
+
+#include <concepts>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ctrx
+{
+// A stateless function object whose result on a T converts to bool, e.g. a ctrx::predicate_result
+template<typename Predicate, typename T>
+concept predicate_on = std::is_empty_v<Predicate> && std::default_initializable<Predicate>
+                       && requires(Predicate const predicate, T const& value) {
+                              {
+                                  predicate(value)
+                              } -> std::convertible_to<bool>;
+                          };
+
+namespace detail
+{
+template<typename T, typename... Ts>
+inline constexpr bool is_one_of = (std::is_same_v<T, Ts> || ...);
+
+// The name of a type as the compiler spells it in the signature of this function, e.g. "positive" (or the whole
+// signature, if the compiler spells it in an unknown way)
+template<typename T>
+[[nodiscard]] constexpr auto type_name() noexcept -> std::string_view
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    std::string_view const signature = __FUNCSIG__;
+    auto const             first     = signature.find("type_name<");
+    auto const             last      = signature.rfind(">(void)");
+    auto const             skip      = std::string_view{"type_name<"}.size();
+#else
+    std::string_view const signature = __PRETTY_FUNCTION__;
+    auto const             first     = signature.find("T = ");
+    auto const             last      = signature.find_first_of(";]", first);
+    auto const             skip      = std::string_view{"T = "}.size();
+#endif
+    if (first == std::string_view::npos || last == std::string_view::npos)
+        return signature;
+    return signature.substr(first + skip, last - first - skip);
+}
+
+// Gives up on a value that violates a predicate but wasn't reported (as a runtime policy or site override skips the
+// precondition), or whose report returned
+[[noreturn]] CTRX_DETAIL_COLD inline void unproven(std::string_view predicate) noexcept
+{
+    std::fprintf(stderr,
+                 "ctrx: value violates %.*s; no proof of it is created\n",
+                 static_cast<int>(predicate.size()),
+                 predicate.data());
+    std::abort();
+}
+} // namespace detail
+
+// A value of type T that is proven to satisfy all Predicates: it can only be created by checking them as preconditions
+// (or from another proof of at least the same predicates), and it is immutable. Functions that take it therefore need
+// not check these preconditions again, so that a value is checked once where it enters, e.g. at an API boundary, and
+// costs nothing further in. The predicates are evaluated whenever preconditions are built in, even if a runtime policy
+// or site override skips their check: a violation is then not reported, but the constructor aborts, as it does after
+// a reported violation returns (HANDLER and FUZZ mode), so that no proof of a violated predicate exists. Where
+// preconditions aren't evaluated at all (OFF and ASSUME mode, ASSERT mode with NDEBUG, or with the precondition level
+// turned off), the proof is taken on trust.
+template<typename T, typename... Predicates>
+    requires(predicate_on<Predicates, T> && ...)
+class validated
+{
+  public:
+    using value_type = T;
+
+    // Tagged, so that a library built with contracts turned off can't lend its unchecked definition to others
+    CTRX_ABI constexpr explicit validated(T value)
+        : m_value(std::move(value))
+    {
+        (check<Predicates>(), ...);
+    }
+
+    // Weakens a proof of more (or reordered) predicates, without checking again
+    template<typename... Proven>
+        requires(!std::is_same_v<validated<T, Proven...>, validated>
+                 && (detail::is_one_of<Predicates, Proven...> && ...))
+    constexpr validated(validated<T, Proven...> const& other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : m_value(other.get())
+    {
+    }
+
+    [[nodiscard]] constexpr auto get() const noexcept -> T const& { return m_value; }
+    [[nodiscard]] constexpr auto operator*() const noexcept -> T const& { return m_value; }
+    [[nodiscard]] constexpr auto operator->() const noexcept -> T const* { return &m_value; }
+    constexpr operator T const&() const noexcept { return m_value; }
+
+    // Gives up the proof, moving the value out
+    [[nodiscard]] constexpr auto release() && noexcept(std::is_nothrow_move_constructible_v<T>) -> T
+    {
+        return std::move(m_value);
+    }
+
+    friend constexpr auto operator==(validated const&, validated const&) -> bool = default;
+
+  private:
+    template<typename Predicate>
+    CTRX_ABI constexpr void check() const
+    {
+        if constexpr (evaluated_v<contract_type::precondition, level::default_>)
+        {
+            // Evaluated once, reported as usual, and never turned into a proof, even if the report was skipped
+            auto const satisfied = Predicate{}(m_value);
+            CTRX_PRECONDITION(satisfied, DEFAULT, "{}", detail::type_name<Predicate>());
+            if (!satisfied)
+                detail::unproven(detail::type_name<Predicate>());
+        }
+        else
+            CTRX_PRECONDITION(Predicate{}(m_value));
+    }
+
+    T m_value;
+};
+
+// Checks value against all Predicates, e.g. ctrx::validate<non_zero>(i) is a ctrx::validated<int, non_zero>
+template<typename... Predicates, typename T>
+[[nodiscard]] CTRX_ABI constexpr auto validate(T value) -> validated<T, Predicates...>
+{
+    return validated<T, Predicates...>{std::move(value)};
+}
+} // namespace ctrx
+
+#endif // CTRX_VALIDATED_HPP
@@ -0,0 +1,47 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef CTRX_VIOLATION_INFO_HPP
+#define CTRX_VIOLATION_INFO_HPP
+
+#include "ctrx/contract_type.hpp"
+#include "ctrx/site_id.hpp"
+
+#include <source_location>
+#include <string_view>
+
+namespace ctrx
+{
+// Describes a violated contract without allocating, e.g. as the error returned by CTRX_PRECONDITION_OR_UNEXPECTED.
+// If strings are stripped, only type and site id are set.
+struct violation_info
+{
+    contract_type        type;
+    site_id_t            site_id;
+    std::string_view     condition;
+    std::string_view     message;
+    std::source_location source_location;
+};
+} // namespace ctrx
+
+#endif // CTRX_VIOLATION_INFO_HPP
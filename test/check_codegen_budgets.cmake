@@ -0,0 +1,93 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+# Checks the overhead of every function ctrx_<name> in BINARY, built in contract mode MODE, over its handwritten form
+# manual_<name>, against the budgets in BUDGETS. Each budget line reads "<mode> <name> <instructions> <stack bytes>",
+# the number of extra instructions and stack frame bytes a passing check may cost. Code in cold sections, i.e. the
+# violation handling the compiler moved out of the way, isn't counted. OFF mode has no budget: it must cost nothing.
+include(${CMAKE_CURRENT_LIST_DIR}/disassembly.cmake)
+ctrx_read_disassembly(asm ${OBJDUMP} ${BINARY})
+
+# Budgets are recorded per compiler, so a compiler without budgets (other than in OFF mode, which needs none) skips the
+# check, and prints what its budgets would be: the measured costs plus 2 instructions and, if there is an extra frame
+# at all, 8 stack bytes of headroom.
+set(recording FALSE)
+if (NOT MODE STREQUAL "OFF" AND NOT EXISTS ${BUDGETS})
+    set(recording TRUE)
+endif ()
+
+set(budget_lines)
+if (EXISTS ${BUDGETS})
+    file(STRINGS ${BUDGETS} budget_lines REGEX "^${MODE} ")
+endif ()
+foreach (line IN LISTS budget_lines)
+    if (NOT line MATCHES "^${MODE} +([A-Za-z0-9_]+) +([0-9]+) +([0-9]+) *$")
+        message(FATAL_ERROR "Malformed budget: ${line}")
+    endif ()
+    set(budget_count_${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+    set(budget_frame_${CMAKE_MATCH_1} ${CMAKE_MATCH_3})
+endforeach ()
+
+set(failed FALSE)
+foreach (function IN LISTS asm_functions)
+    if (NOT function MATCHES "^ctrx_([A-Za-z0-9_]*)$")
+        continue()
+    endif ()
+    set(name ${CMAKE_MATCH_1})
+    if (NOT DEFINED asm_count_manual_${name})
+        message(SEND_ERROR "${function} has no handwritten counterpart manual_${name}")
+        set(failed TRUE)
+        continue()
+    endif ()
+    if (recording)
+        math(EXPR count "${asm_count_${function}} - ${asm_count_manual_${name}} + 2")
+        math(EXPR frame "${asm_frame_${function}} - ${asm_frame_manual_${name}}")
+        if (frame GREATER 0)
+            math(EXPR frame "${frame} + 8")
+        endif ()
+        message(STATUS "${MODE} ${name} ${count} ${frame}")
+        continue()
+    elseif (MODE STREQUAL "OFF")
+        set(budget_count_${name} 0)
+        set(budget_frame_${name} 0)
+    elseif (NOT DEFINED budget_count_${name})
+        message(SEND_ERROR "No ${MODE} budget for ${name} in ${BUDGETS}")
+        set(failed TRUE)
+        continue()
+    endif ()
+
+    math(EXPR count "${asm_count_${function}} - ${asm_count_manual_${name}}")
+    math(EXPR frame "${asm_frame_${function}} - ${asm_frame_manual_${name}}")
+    set(report "${name}: ${count}/${budget_count_${name}} extra instructions")
+    string(APPEND report ", ${frame}/${budget_frame_${name}} extra stack bytes")
+    if (count GREATER budget_count_${name} OR frame GREATER budget_frame_${name})
+        message(SEND_ERROR "${report}")
+        set(failed TRUE)
+    else ()
+        message(STATUS "${report}")
+    endif ()
+endforeach ()
+if (recording)
+    message(STATUS "No code generation budgets recorded in ${BUDGETS}; the lines above would be those of ${MODE} mode")
+elseif (failed)
+    message(FATAL_ERROR "Contracts in ${MODE} mode exceed their code generation budget")
+endif ()
@@ -0,0 +1,96 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Verifies the SDT probes of BINARY, as listed by READELF: every contract site of SITE_MAP must have a violation probe
+# (and a check probe, if CHECKS is set) whose arguments are its site id, contract type and level, and every probe must
+# be a single nop, as disassembled by OBJDUMP.
+execute_process(COMMAND ${READELF} --notes --wide ${BINARY} OUTPUT_VARIABLE notes RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${READELF} failed on ${BINARY}")
+endif ()
+
+# Collects the probes of the provider ctrx as "<name> <site> <type> <level>", and their locations
+string(REPLACE "\n" ";" lines "${notes}")
+set(probes)
+set(locations)
+set(provider)
+set(name)
+set(location)
+foreach (line IN LISTS lines)
+    if (line MATCHES "Provider: ([^ \t]+)")
+        set(provider ${CMAKE_MATCH_1})
+    elseif (line MATCHES "Name: ([^ \t]+)")
+        set(name ${CMAKE_MATCH_1})
+    elseif (line MATCHES "Location: (0x[0-9a-f]+)")
+        set(location ${CMAKE_MATCH_1})
+    elseif (line MATCHES "Arguments: (.*)$" AND provider STREQUAL "ctrx")
+        set(arguments ${CMAKE_MATCH_1})
+        if (NOT arguments MATCHES "^8@\\$?([0-9]+) 4@\\$?([0-9]+) 4@\\$?([0-9]+)$")
+            message(FATAL_ERROR "Probe ${name} at ${location} has unexpected arguments: ${arguments}")
+        endif ()
+        list(APPEND probes "${name} ${CMAKE_MATCH_1} ${CMAKE_MATCH_2} ${CMAKE_MATCH_3}")
+        list(APPEND locations ${location})
+    endif ()
+endforeach ()
+list(LENGTH probes count)
+message(STATUS "Found ${count} ctrx probes")
+if (count EQUAL 0)
+    message(FATAL_ERROR "${BINARY} contains no ctrx probes")
+endif ()
+
+foreach (location IN LISTS locations)
+    math(EXPR stop "${location} + 1" OUTPUT_FORMAT HEXADECIMAL)
+    execute_process(COMMAND ${OBJDUMP} --disassemble --start-address=${location} --stop-address=${stop} ${BINARY}
+            OUTPUT_VARIABLE disassembly)
+    if (NOT disassembly MATCHES "\tnop")
+        message(FATAL_ERROR "Probe at ${location} is not a nop:\n${disassembly}")
+    endif ()
+endforeach ()
+
+# The numbers of the contract types and levels, as in ctrx::contract_type and CTRX_DETAIL_LEVEL_NUM_* (which start at 1)
+set(types PRECONDITION POSTCONDITION ASSERTION INVARIANT)
+set(levels NONE OFF DEFAULT AUDIT AXIOM O_1 O_LOG_N O_N O_N_LOG_N O_N2)
+
+file(STRINGS ${SITE_MAP} sites REGEX "^0x")
+foreach (site IN LISTS sites)
+    string(REPLACE "\t" ";" fields "${site}")
+    list(GET fields 0 id)
+    list(GET fields 3 type)
+    list(GET fields 4 level)
+    math(EXPR id "${id}")
+    string(TOUPPER ${type} type)
+    string(TOUPPER ${level} level)
+    list(FIND types ${type} type)
+    list(FIND levels ${level} level)
+
+    set(expected violation)
+    if (CHECKS)
+        list(APPEND expected check)
+    endif ()
+    foreach (name IN LISTS expected)
+        list(FIND probes "${name} ${id} ${type} ${level}" index)
+        if (index EQUAL -1)
+            message(FATAL_ERROR "Missing ${name} probe of contract site ${site}")
+        endif ()
+    endforeach ()
+endforeach ()
@@ -0,0 +1,46 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+# Fails if any function ctrx_<name> in BINARY has more instructions than its handwritten counterpart manual_<name>.
+# Compares the instruction counts of every function ctrx_<name> in BINARY with its handwritten form manual_<name>.
+include(${CMAKE_CURRENT_LIST_DIR}/disassembly.cmake)
+ctrx_read_disassembly(asm ${OBJDUMP} ${BINARY})
+
+set(failed FALSE)
+foreach (function IN LISTS asm_functions)
+    if (NOT function MATCHES "^ctrx_([A-Za-z0-9_]*)$")
+        continue()
+    endif ()
+    set(manual manual_${CMAKE_MATCH_1})
+    if (NOT DEFINED asm_count_${manual})
+        message(SEND_ERROR "${function} has no handwritten counterpart ${manual}")
+        set(failed TRUE)
+    elseif (asm_count_${function} GREATER asm_count_${manual})
+        message(SEND_ERROR "${function}: ${asm_count_${function}} instructions, ${manual}: ${asm_count_${manual}}")
+        set(failed TRUE)
+    else ()
+        message(STATUS "${function}: ${asm_count_${function}} instructions, ${manual}: ${asm_count_${manual}}")
+    endif ()
+endforeach ()
+if (failed)
+    message(FATAL_ERROR "Checked code generates more instructions than its handwritten form")
+endif ()
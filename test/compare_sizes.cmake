@@ -0,0 +1,43 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Reports the binary sizes of BASELINE and REDUCED, and fails if the latter isn't smaller. LABEL describes what was done
+# to get from BASELINE to REDUCED. If ABSENT is set, additionally fails if REDUCED contains a string matching it.
+file(SIZE ${BASELINE} baseline)
+file(SIZE ${REDUCED} reduced)
+math(EXPR reduction "${baseline} - ${reduced}")
+
+message(STATUS "Baseline:  ${baseline} bytes")
+message(STATUS "Reduced:   ${reduced} bytes (${LABEL})")
+message(STATUS "Reduction: ${reduction} bytes")
+
+if (NOT reduced LESS baseline)
+    message(FATAL_ERROR "${LABEL} did not reduce the binary size")
+endif ()
+
+if (DEFINED ABSENT)
+    file(STRINGS ${REDUCED} found REGEX "${ABSENT}")
+    if (found)
+        message(FATAL_ERROR "${LABEL} left strings in the binary: ${found}")
+    endif ()
+endif ()
@@ -0,0 +1,72 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+# Disassembles BINARY with OBJDUMP and sets, in the calling scope, ${PREFIX}_functions to the functions found, and for
+# each function f ${PREFIX}_count_f to its number of instructions (not counting padding) and ${PREFIX}_frame_f to the
+# bytes it reserves on the stack (pushed registers and explicit adjustments, x86-64 and AArch64 only). Code that the
+# compiler moved to cold sections (f.cold) is attributed to a function of its own.
+function(ctrx_read_disassembly PREFIX OBJDUMP BINARY)
+    execute_process(
+            COMMAND ${OBJDUMP} -d --no-show-raw-insn ${BINARY}
+            OUTPUT_VARIABLE disassembly
+            RESULT_VARIABLE result
+    )
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed to disassemble ${BINARY}")
+    endif ()
+
+    string(REPLACE ";" "," disassembly "${disassembly}")
+    string(REPLACE "\n" ";" lines "${disassembly}")
+    set(functions)
+    set(current)
+    foreach (line IN LISTS lines)
+        if (line MATCHES "^[0-9a-f]+ <([A-Za-z0-9_.]+)>:$")
+            set(current ${CMAKE_MATCH_1})
+            set(count_${current} 0)
+            set(frame_${current} 0)
+            list(APPEND functions ${current})
+        elseif (current AND line MATCHES "^ *[0-9a-f]+:\t" AND NOT line MATCHES "\t(nop|xchg +%ax,%ax|data16|int3)")
+            math(EXPR count_${current} "${count_${current}} + 1")
+            if (line MATCHES "\tpush +%")
+                math(EXPR frame_${current} "${frame_${current}} + 8")
+            elseif (line MATCHES "\tadd +\\$0xffffffff([0-9a-f]+),%rsp") # Adding a negative value, e.g. -128
+                math(EXPR frame_${current} "${frame_${current}} + 0x100000000 - 0x${CMAKE_MATCH_1}")
+            elseif (line MATCHES "\tsub +\\$0xffffffff[0-9a-f]+,%rsp") # Subtracting a negative value frees the frame
+            elseif (line MATCHES "\tsub +\\$(0x[0-9a-f]+),%rsp")
+                math(EXPR frame_${current} "${frame_${current}} + ${CMAKE_MATCH_1}")
+            elseif (line MATCHES "\tstp +[^,]+, [^,]+, \\[sp, #-([0-9]+)\\]!")
+                math(EXPR frame_${current} "${frame_${current}} + ${CMAKE_MATCH_1}")
+            elseif (line MATCHES "\tsub +sp, sp, #(0x[0-9a-f]+|[0-9]+)")
+                math(EXPR frame_${current} "${frame_${current}} + ${CMAKE_MATCH_1}")
+            endif ()
+        endif ()
+    endforeach ()
+    if (NOT functions)
+        message(FATAL_ERROR "No functions found in ${BINARY}")
+    endif ()
+
+    set(${PREFIX}_functions ${functions} PARENT_SCOPE)
+    foreach (function IN LISTS functions)
+        set(${PREFIX}_count_${function} ${count_${function}} PARENT_SCOPE)
+        set(${PREFIX}_frame_${function} ${frame_${function}} PARENT_SCOPE)
+    endforeach ()
+endfunction()
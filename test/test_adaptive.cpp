@@ -0,0 +1,142 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_LEVEL AUDIT
+#define CTRX_CONFIG_ADAPTIVE
+#include "ctrx/contracts.hpp"
+#include "ctrx/snapshot.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+auto sum(std::vector<int> const& v) -> long
+{
+    return std::accumulate(v.begin(), v.end(), 0L);
+}
+
+auto expensive(std::vector<int> const& v) -> int
+{
+    CTRX_PRECONDITION(sum(v) == static_cast<long>(v.size()), audit);
+    return v.front();
+}
+auto rare(std::vector<int> const& v) -> int
+{
+    CTRX_PRECONDITION(sum(v) == static_cast<long>(v.size()), o_n);
+    return v.back();
+}
+auto cheap(std::vector<int> const& v) -> int
+{
+    CTRX_PRECONDITION(!v.empty());
+    return v.front();
+}
+void violation()
+{
+    CTRX_ASSERT(false, audit);
+}
+auto unchanged(std::vector<int> const& v) -> int
+{
+    CTRX_SNAPSHOT(v, audit);
+    int const front = v.front();
+    CTRX_ASSERT_UNCHANGED(v, audit);
+    return front;
+}
+constexpr unsigned unchanged_line = __LINE__ - 5;
+
+auto find(std::vector<ctrx::adaptive_entry> const& entries, unsigned line) -> ctrx::adaptive_entry const*
+{
+    auto const iter = std::find_if(entries.begin(),
+                                   entries.end(),
+                                   [&](ctrx::adaptive_entry const& e) { return e.source_location.line() == line; });
+    return iter == entries.end() ? nullptr : &*iter;
+}
+
+TEST_CASE("adaptive checking", "[ctrx]", runtime)
+{
+    std::vector<int> const v(4096, 1);
+    long                   result     = 0;
+    long                   iterations = 0;
+    long                   rare_calls = 0;
+
+    // The controller needs a few windows to settle, which depends on the speed of the machine and the build
+    auto const throttled = []
+    {
+        auto const entries = ctrx::adaptive_report();
+        return !entries.empty() && entries.front().evaluations * 2 < entries.front().calls;
+    };
+    for (; iterations < 2'000'000 && (iterations % 1000 != 0 || !throttled()); ++iterations)
+    {
+        result += expensive(v) + cheap(v);
+        if (iterations % 5000 == 0)
+        {
+            result += rare(v);
+            ++rare_calls;
+        }
+    }
+    CHECK(result == 2 * iterations + rare_calls);
+
+    auto const  entries         = ctrx::adaptive_report();
+    auto const* expensive_entry = find(entries, 44);
+    auto const* rare_entry      = find(entries, 49);
+    REQUIRE(expensive_entry != nullptr);
+    REQUIRE(rare_entry != nullptr);
+    CHECK(find(entries, 54) == nullptr); // O(1) contracts aren't sampled
+
+    CHECK(expensive_entry->level == std::string_view{"AUDIT"});
+    CHECK(expensive_entry->evaluations > 0);
+    CHECK(expensive_entry->evaluations < expensive_entry->calls);
+    CHECK(expensive_entry->rate < 1.0);
+    CHECK(expensive_entry->cost > 0.0);
+
+    CHECK(rare_entry->calls == static_cast<std::uint_least64_t>(rare_calls));
+    CHECK(rare_entry->evaluations == static_cast<std::uint_least64_t>(rare_calls));
+
+    // The first calls of a site are always checked, so violations are still reported
+    CHECK_THROWS_AS(ctrx::assertion_violation, violation());
+}
+
+TEST_CASE("adaptive checking of snapshots", "[ctrx]", runtime)
+{
+    std::vector<int> const v(4096, 1);
+    for (int i = 0; i < 1000; ++i)
+        CHECK(unchanged(v) == 1);
+
+    // The snapshot is sampled, and its check along with it
+    auto const  entries = ctrx::adaptive_report();
+    auto const* entry   = find(entries, unchanged_line);
+    REQUIRE(entry != nullptr);
+    CHECK(entry->condition == std::string_view{"v"});
+    CHECK(entry->calls > 0);
+    CHECK(find(entries, unchanged_line + 2) == nullptr);
+}
+
+TEST_CASE("adaptive checking (constexpr)", "[ctrx]", compiletime)
+{
+    CTRX_PRECONDITION(true, audit);
+    CTRX_PRECONDITION(true, o_n);
+}
+EVAL_TEST_CASE("adaptive checking (constexpr)");
@@ -0,0 +1,121 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/contracts.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <regex>
+#include <stdexcept>
+
+auto counted(int& counter, bool result) -> bool
+{
+    ++counter;
+    return result;
+}
+
+auto throws() -> bool
+{
+    throw std::runtime_error{"what message"};
+    return true;
+}
+
+void preconditions(int i, int n)
+{
+    CTRX_PRECONDITIONS(i >= 0, i < n, n != 3);
+}
+void postconditions(int i)
+{
+    CTRX_POSTCONDITIONS(i != 0, i != 1);
+}
+void assertions(int i)
+{
+    CTRX_ASSERTS(i != 0);
+}
+
+TEST_CASE("batched contracts", "[ctrx]", runtime)
+{
+    SECTION("all conditions pass")
+    {
+        CHECK_NOTHROW(preconditions(0, 1));
+        CHECK_NOTHROW(postconditions(2));
+        CHECK_NOTHROW(assertions(1));
+    }
+    SECTION("failures are reported with their own type")
+    {
+        CHECK_THROWS_AS(ctrx::precondition_violation, preconditions(-1, 1));
+        CHECK_THROWS_AS(ctrx::precondition_violation, preconditions(1, 1));
+        CHECK_THROWS_AS(ctrx::precondition_violation, preconditions(0, 3));
+        CHECK_THROWS_AS(ctrx::postcondition_violation, postconditions(1));
+        CHECK_THROWS_AS(ctrx::assertion_violation, assertions(0));
+    }
+    SECTION("failures are reported with their own text")
+    {
+        try
+        {
+            preconditions(1, 1);
+        }
+        catch (ctrx::precondition_violation const& e)
+        {
+            CAPTURE(e.what());
+            CHECK(std::regex_match(e.what(), std::regex(R"(^.*PRECONDITION failure: i < n .*$)")));
+        }
+        try
+        {
+            preconditions(0, 3);
+        }
+        catch (ctrx::precondition_violation const& e)
+        {
+            CAPTURE(e.what());
+            CHECK(std::regex_match(e.what(), std::regex(R"(^.*PRECONDITION failure: n != 3 .*$)")));
+        }
+    }
+    SECTION("conditions are not short-circuited")
+    {
+        int first  = 0;
+        int second = 0;
+        CTRX_ASSERTS(counted(first, true), counted(second, true));
+        CHECK(first == 1);
+        CHECK(second == 1);
+    }
+    SECTION("exceptions during evaluation")
+    {
+        try
+        {
+            CTRX_ASSERTS(true, throws());
+        }
+        catch (ctrx::assertion_violation const& e)
+        {
+            CAPTURE(e.what());
+            CHECK(std::regex_match(e.what(), std::regex(R"(^.*ASSERTION failure: throws\(\): what message.*$)")));
+        }
+    }
+}
+
+TEST_CASE("batched contracts (constexpr)", "[ctrx]", compiletime)
+{
+    CTRX_PRECONDITIONS(true, true, true);
+    CTRX_POSTCONDITIONS(true);
+    CTRX_ASSERTS(true, (1 + 1 == 2));
+}
+EVAL_TEST_CASE("batched contracts (constexpr)");
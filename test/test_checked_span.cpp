@@ -0,0 +1,122 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/checked_span.hpp"
+#include "ctrx/checked_vector.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+static_assert(std::random_access_iterator<ctrx::checked_span<int>::iterator>);
+static_assert(std::random_access_iterator<ctrx::checked_vector<int>::const_iterator>);
+static_assert(std::is_convertible_v<ctrx::checked_vector<int>::iterator, ctrx::checked_vector<int>::const_iterator>);
+static_assert(std::is_convertible_v<ctrx::checked_span<int>, ctrx::checked_span<int const>>);
+static_assert(std::is_convertible_v<ctrx::checked_vector<int>&, ctrx::checked_span<int>>);
+static_assert(!std::is_convertible_v<ctrx::checked_vector<int>, ctrx::checked_span<int>>);
+
+TEST_CASE("checked_span", "[ctrx]", runtime)
+{
+    std::array<int, 4>       values{1, 2, 3, 4};
+    ctrx::checked_span const span{values};
+
+    CHECK(span.size() == 4);
+    CHECK(span[3] == 4);
+    CHECK(span.front() == 1);
+    CHECK(span.back() == 4);
+    CHECK(std::accumulate(span.begin(), span.end(), 0) == 10);
+    CHECK(std::accumulate(span.rbegin(), span.rend(), 0) == 10);
+    CHECK(span.subspan(1, 2).back() == 3);
+    CHECK(span.last(1).front() == 4);
+
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(span[4]));
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(span.first(5)));
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(span.subspan(3, 2)));
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(span.first(0).front()));
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(*span.end()));
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(span.begin() + 5));
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(span.end()[-5]));
+    CHECK_THROWS_AS(ctrx::precondition_violation, --span.begin());
+    CHECK_THROWS_AS(ctrx::precondition_violation, ++span.end());
+
+    try
+    {
+        static_cast<void>(span[7]);
+    }
+    catch (ctrx::precondition_violation const& e)
+    {
+        CAPTURE(e.what());
+        CHECK(std::string_view{e.what()}.find("index 7 is out of range for size 4") != std::string_view::npos);
+    }
+}
+
+TEST_CASE("checked_vector", "[ctrx]", runtime)
+{
+    ctrx::checked_vector<int> vector{1, 2, 3};
+    vector.push_back(4);
+    vector.erase(vector.begin());
+    vector.insert(vector.end(), 5);
+
+    CHECK(vector.unchecked() == std::vector<int>{2, 3, 4, 5});
+    CHECK(vector[0] == 2);
+    CHECK(vector.front() == 2);
+    CHECK(vector.back() == 5);
+    CHECK(std::find(vector.begin(), vector.end(), 4) - vector.begin() == 2);
+
+    ctrx::checked_span<int const> const span = vector;
+    CHECK(span.size() == 4);
+
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(vector[4]));
+    CHECK_THROWS_AS(ctrx::precondition_violation, vector.erase(vector.end()));
+    CHECK_THROWS_AS(ctrx::precondition_violation, vector.erase(vector.begin() + 2, vector.begin() + 1));
+    CHECK(vector.unchecked() == std::vector<int>{2, 3, 4, 5});
+
+    ctrx::checked_vector<int> other{6};
+    CHECK_THROWS_AS(ctrx::precondition_violation, vector.erase(other.begin()));
+    CHECK_THROWS_AS(ctrx::precondition_violation, vector.erase(vector.begin(), other.end()));
+    CHECK_THROWS_AS(ctrx::precondition_violation, vector.insert(other.begin(), 7));
+    CHECK(vector.unchecked() == std::vector<int>{2, 3, 4, 5});
+    CHECK_THROWS_AS(std::out_of_range, static_cast<void>(vector.at(4)));
+
+    vector.clear();
+    CHECK_THROWS_AS(ctrx::precondition_violation, static_cast<void>(vector.front()));
+    CHECK_THROWS_AS(ctrx::precondition_violation, vector.pop_back());
+}
+
+TEST_CASE("checked containers (constexpr)", "[ctrx]", compiletime)
+{
+    ctrx::checked_vector<int> vector(3, 1);
+    vector.push_back(2);
+    CHECK(std::accumulate(vector.begin(), vector.end(), 0) == 5);
+
+    ctrx::checked_span<int const> const span = vector;
+    CHECK(span[3] == 2);
+    CHECK(span.subspan(1).size() == 3);
+}
+EVAL_TEST_CASE("checked containers (constexpr)");
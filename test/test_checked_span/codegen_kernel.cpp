@@ -0,0 +1,104 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE CTRX_CODEGEN_MODE
+#include "ctrx/checked_span.hpp"
+#include "ctrx/checked_vector.hpp"
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <vector>
+
+// Accesses through the checked adapters (ctrx_<name>) next to the same accesses through std::span and std::vector
+// (manual_<name>), whose instruction counts are compared. In the modes that don't check, both must compile to the same
+// code. In the modes that do, so must loops, whose checks are implied by the loop condition.
+
+#if !CTRX_DETAIL_CHECKED_ITERATORS
+extern "C" auto ctrx_span_element(ctrx::checked_span<int const> span, std::size_t index) -> int
+{
+    return span[index];
+}
+extern "C" auto manual_span_element(std::span<int const> span, std::size_t index) -> int
+{
+    return span[index];
+}
+
+extern "C" auto ctrx_span_back(ctrx::checked_span<int const> span) -> int
+{
+    return span.back();
+}
+extern "C" auto manual_span_back(std::span<int const> span) -> int
+{
+    return span.back();
+}
+
+extern "C" auto ctrx_vector_element(ctrx::checked_vector<int> const& vector, std::size_t index) -> int
+{
+    return vector[index];
+}
+extern "C" auto manual_vector_element(std::vector<int> const& vector, std::size_t index) -> int
+{
+    return vector[index];
+}
+#endif
+
+extern "C" auto ctrx_span_sum(ctrx::checked_span<int const> span) -> int
+{
+    int sum = 0;
+    for (int value : span)
+        sum += value;
+    return sum;
+}
+extern "C" auto manual_span_sum(std::span<int const> span) -> int
+{
+    int sum = 0;
+    for (int value : span)
+        sum += value;
+    return sum;
+}
+
+extern "C" auto ctrx_span_indexed_sum(ctrx::checked_span<int const> span) -> int
+{
+    int sum = 0;
+    for (std::size_t i = 0; i < span.size(); ++i)
+        sum += span[i];
+    return sum;
+}
+extern "C" auto manual_span_indexed_sum(std::span<int const> span) -> int
+{
+    int sum = 0;
+    for (std::size_t i = 0; i < span.size(); ++i)
+        sum += span[i];
+    return sum;
+}
+
+extern "C" auto ctrx_vector_sum(ctrx::checked_vector<int> const& vector) -> int
+{
+    return std::accumulate(vector.begin(), vector.end(), 0);
+}
+extern "C" auto manual_vector_sum(std::vector<int> const& vector) -> int
+{
+    return std::accumulate(vector.begin(), vector.end(), 0);
+}
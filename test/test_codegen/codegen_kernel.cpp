@@ -0,0 +1,93 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE CTRX_CODEGEN_MODE
+#include "ctrx/contracts.hpp"
+
+#include <cstddef>
+
+// Reference kernels with contracts (ctrx_<name>) next to the same kernels without them (manual_<name>). This file is
+// built once per mode, and the instruction counts and stack frames of both forms are compared against budgets.
+
+extern "C" auto ctrx_element(int const* data, std::size_t size, std::size_t index) -> int
+{
+    CTRX_PRECONDITION(index < size);
+    return data[index];
+}
+extern "C" auto manual_element(int const* data, std::size_t, std::size_t index) -> int
+{
+    return data[index];
+}
+
+extern "C" auto ctrx_divide(int dividend, int divisor) -> int
+{
+    CTRX_PRECONDITION(divisor != 0);
+    return dividend / divisor;
+}
+extern "C" auto manual_divide(int dividend, int divisor) -> int
+{
+    return dividend / divisor;
+}
+
+extern "C" auto ctrx_sum(int const* data, std::size_t size) -> long
+{
+    CTRX_PRECONDITION(data != nullptr || size == 0);
+    long sum = 0;
+    for (std::size_t i = 0; i < size; ++i)
+        sum += data[i];
+    return sum;
+}
+extern "C" auto manual_sum(int const* data, std::size_t size) -> long
+{
+    long sum = 0;
+    for (std::size_t i = 0; i < size; ++i)
+        sum += data[i];
+    return sum;
+}
+
+extern "C" auto ctrx_saturate(int value, int limit) -> int
+{
+    CTRX_PRECONDITION(limit >= 0);
+    int const result = value > limit ? limit : (value < -limit ? -limit : value);
+    CTRX_POSTCONDITION(result <= limit && result >= -limit);
+    return result;
+}
+extern "C" auto manual_saturate(int value, int limit) -> int
+{
+    return value > limit ? limit : (value < -limit ? -limit : value);
+}
+
+extern "C" auto ctrx_copy(int* destination, int const* source, std::size_t size) -> void
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        CTRX_ASSERT(source[i] >= 0);
+        destination[i] = source[i];
+    }
+}
+extern "C" auto manual_copy(int* destination, int const* source, std::size_t size) -> void
+{
+    for (std::size_t i = 0; i < size; ++i)
+        destination[i] = source[i];
+}
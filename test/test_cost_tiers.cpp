@@ -0,0 +1,103 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_MAX_COST O_N
+#include "ctrx/configuration.hpp"
+#include "ctrx/contracts.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+void o_1_failure()
+{
+    CTRX_PRECONDITION(false, o_1);
+}
+void o_log_n_failure()
+{
+    CTRX_PRECONDITION(false, o_log_n);
+}
+void o_n_failure()
+{
+    CTRX_POSTCONDITION(false, O_N);
+}
+void o_n_log_n_failure()
+{
+    CTRX_ASSERT(false, o_n_log_n);
+}
+void o_n2_failure()
+{
+    CTRX_ASSERT(false, o_n2);
+}
+void default_failure()
+{
+    CTRX_ASSERT(false, default);
+}
+void audit_failure()
+{
+    CTRX_ASSERT(false, audit);
+}
+
+TEST_CASE("cost tiers", "[ctrx]", runtime)
+{
+    SECTION("up to the configured maximum")
+    {
+        CHECK_THROWS_AS(ctrx::precondition_violation, o_1_failure());
+        CHECK_THROWS_AS(ctrx::precondition_violation, o_log_n_failure());
+        CHECK_THROWS_AS(ctrx::postcondition_violation, o_n_failure());
+        CHECK_NOTHROW(o_n_log_n_failure());
+        CHECK_NOTHROW(o_n2_failure());
+    }
+    SECTION("classic levels")
+    {
+        CHECK_THROWS_AS(ctrx::assertion_violation, default_failure());
+        CHECK_NOTHROW(audit_failure());
+    }
+    SECTION("runtime maximum")
+    {
+        CHECK(ctrx::max_cost() == ctrx::cost::o_n2);
+        ctrx::set_max_cost(ctrx::cost::o_1);
+        CHECK_THROWS_AS(ctrx::precondition_violation, o_1_failure());
+        CHECK_NOTHROW(o_log_n_failure());
+        CHECK_NOTHROW(o_n_failure());
+        CHECK_THROWS_AS(ctrx::assertion_violation, default_failure());
+
+        ctrx::set_max_cost(ctrx::cost::o_log_n);
+        CHECK_THROWS_AS(ctrx::precondition_violation, o_log_n_failure());
+        CHECK_NOTHROW(o_n_failure());
+
+        ctrx::set_max_cost(ctrx::cost::o_n2);
+        CHECK_THROWS_AS(ctrx::postcondition_violation, o_n_failure());
+        CHECK_NOTHROW(o_n_log_n_failure());
+    }
+    SECTION("configuration")
+    {
+        CHECK(ctrx::build_configuration().precondition.level == "O_N");
+    }
+}
+
+TEST_CASE("cost tiers (constexpr)", "[ctrx]", compiletime)
+{
+    CTRX_PRECONDITION(true, o_1);
+    CTRX_PRECONDITION(true, o_n);
+    CTRX_PRECONDITION(false, o_n2);
+}
+EVAL_TEST_CASE("cost tiers (constexpr)");
@@ -0,0 +1,115 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE TERMINATE
+#include "ctrx/contracts.hpp"
+
+#include <regex>
+#include <string>
+
+#if __has_include(<sys/wait.h>)
+#include <sys/wait.h>
+#include <unistd.h>
+
+auto read_all(int fd) -> std::string
+{
+    std::string result;
+    char        buf[256];
+    for (auto n = ::read(fd, buf, sizeof(buf)); n > 0; n = ::read(fd, buf, sizeof(buf)))
+        result.append(buf, static_cast<std::size_t>(n));
+    return result;
+}
+
+auto positive(int i) -> int
+{
+    CTRX_PRECONDITION(i > 0, default, "must be positive");
+    return i;
+}
+
+TEST_CASE("crash record", "[ctrx]", runtime)
+{
+    SECTION("record format")
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        ctrx::detail::write_crash_record(fds[1], "ASSERTION", "x == 1", std::source_location::current());
+        ::close(fds[1]);
+        std::string const record = read_all(fds[0]);
+        ::close(fds[0]);
+        CAPTURE(record);
+        CHECK(std::regex_match(
+            record,
+            std::regex(R"(^ctrx: ASSERTION violation: x == 1 at .*test_crash_record.cpp:\d+.*\n$)")));
+    }
+    SECTION("disabled record")
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        ctrx::detail::write_crash_record(-1, "ASSERTION", "x == 1", std::source_location::current());
+        ::close(fds[1]);
+        CHECK(read_all(fds[0]).empty());
+        ::close(fds[0]);
+    }
+    SECTION("record fd")
+    {
+        int const old_fd = ctrx::crash_record_fd();
+        ctrx::set_crash_record_fd(42);
+        CHECK(ctrx::crash_record_fd() == 42);
+        ctrx::set_crash_record_fd(old_fd);
+    }
+    SECTION("record is written before terminating")
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        pid_t const pid = ::fork();
+        REQUIRE(pid >= 0);
+        if (pid == 0)
+        {
+            ::close(fds[0]);
+            ctrx::set_crash_record_fd(fds[1]);
+            positive(0);
+            ::_exit(0);
+        }
+        ::close(fds[1]);
+        std::string const record = read_all(fds[0]);
+        ::close(fds[0]);
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        CAPTURE(record);
+        CHECK(WIFSIGNALED(status));
+        CHECK(std::regex_match(record,
+                               std::regex(R"(^ctrx: PRECONDITION violation: i > 0 \(must be positive\) at )"
+                                          R"(.*test_crash_record.cpp:\d+.*\n$)")));
+    }
+}
+#endif
+
+TEST_CASE("crash record (passing checks)", "[ctrx]", runtime)
+{
+    CTRX_PRECONDITION(true);
+    CTRX_POSTCONDITION(true);
+    CTRX_ASSERT(true);
+}
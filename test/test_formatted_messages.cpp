@@ -0,0 +1,104 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/contracts.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <string>
+#include <string_view>
+
+int formatted_count = 0;
+
+auto counted(int value) -> int
+{
+    ++formatted_count;
+    return value;
+}
+
+auto push(int size, int capacity, std::string_view queue) -> int
+{
+    CTRX_PRECONDITION(size < capacity, default, "queue {} is full at depth {}", queue, counted(size));
+    return size + 1;
+}
+
+struct bounded
+{
+    int value = 0;
+    int max   = 10;
+
+    void set(int v)
+    {
+        CTRX_INVARIANT_GUARD(value <= max, default, "value {} exceeds {}", value, max);
+        value = v;
+    }
+};
+
+auto what_of(auto f) -> std::string
+{
+    try
+    {
+        f();
+    }
+    catch (ctrx::contract_violation const& e)
+    {
+        return e.what();
+    }
+    return "";
+}
+
+TEST_CASE("formatted messages", "[ctrx]", runtime)
+{
+    SECTION("formatted on failure only")
+    {
+        formatted_count = 0;
+        CHECK(push(1, 2, "orders") == 2);
+        CHECK(formatted_count == 0);
+        auto const what = what_of([] { push(2, 2, "orders"); });
+        CAPTURE(what);
+        CHECK(what.find("PRECONDITION failure: size < capacity (queue orders is full at depth 2)")
+              != std::string::npos);
+        CHECK(formatted_count == 1);
+    }
+    SECTION("escaped braces")
+    {
+        auto const what = what_of([] { CTRX_ASSERT(false, default, "{{{}}}", true); });
+        CAPTURE(what);
+        CHECK(what.find("ASSERTION failure: false ({true})") != std::string::npos);
+    }
+    SECTION("invariant guards")
+    {
+        bounded b;
+        auto const what = what_of([&] { b.set(11); });
+        CAPTURE(what);
+        CHECK(what.find("INVARIANT failure: value <= max (value 11 exceeds 10)") != std::string::npos);
+    }
+}
+
+TEST_CASE("formatted messages (constexpr)", "[ctrx]", compiletime)
+{
+    int const depth = 1;
+    CTRX_PRECONDITION(true, default, "{}", depth);
+    CTRX_POSTCONDITION(true, audit, "{} {}", depth, depth);
+}
+EVAL_TEST_CASE("formatted messages (constexpr)");
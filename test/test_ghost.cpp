@@ -0,0 +1,139 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+#include "ctrx/ghost.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+using ctrx::contract_type;
+using ctrx::ghost;
+using ctrx::level;
+
+// At the DEFAULT level, ghosts of DEFAULT contracts hold state; those of AUDIT and AXIOM contracts don't
+static_assert(ghost<int>::enabled);
+static_assert(ghost<int, contract_type::precondition, level::o_log_n>::enabled);
+static_assert(!ghost<int, contract_type::invariant, level::audit>::enabled);
+static_assert(!ghost<int, contract_type::assertion, level::o_n>::enabled);
+static_assert(!ghost<int, contract_type::assertion, level::axiom>::enabled);
+static_assert(std::is_empty_v<ghost<std::uint64_t, contract_type::invariant, level::audit>>);
+
+// Hot structs with ghost state, which only costs space when it's checked
+struct cursor
+{
+    std::uint32_t                               head;
+    std::uint32_t                               tail;
+    CTRX_NO_UNIQUE_ADDRESS ghost<std::uint64_t> generation;
+};
+struct audited_cursor
+{
+    std::uint32_t                                                                         head;
+    std::uint32_t                                                                         tail;
+    CTRX_NO_UNIQUE_ADDRESS ghost<std::uint64_t, contract_type::invariant, level::audit>   generation;
+    CTRX_NO_UNIQUE_ADDRESS ghost<std::thread::id, contract_type::assertion, level::audit> owner;
+};
+static_assert(sizeof(cursor) == 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t));
+static_assert(sizeof(audited_cursor) == 2 * sizeof(std::uint32_t));
+
+// A stack that counts its pushes and pops for checking only, and its generation when audited
+class bounded_stack
+{
+  public:
+    constexpr void push(int value)
+    {
+        CTRX_PRECONDITION(m_size < m_values.size());
+        m_values[m_size++] = value;
+        CTRX_GHOST(m_pushes, ++*m_pushes);
+        CTRX_GHOST(m_generation, ++*m_generation);
+        check();
+    }
+
+    constexpr auto pop() -> int
+    {
+        CTRX_PRECONDITION(m_size > 0);
+        CTRX_GHOST(m_pops, ++*m_pops);
+        CTRX_GHOST(m_generation, ++*m_generation);
+        auto const value = m_values[--m_size];
+        check();
+        return value;
+    }
+
+    // Loses an element behind the bookkeeping's back
+    constexpr void corrupt() { --m_size; }
+
+    constexpr void check() const
+    {
+        CTRX_INVARIANT(m_pushes - m_pops == m_size);
+        CTRX_INVARIANT(m_generation == m_pushes + m_pops, audit);
+    }
+
+  private:
+    std::array<int, 8>                                                                m_values{};
+    std::size_t                                                                       m_size = 0;
+    CTRX_NO_UNIQUE_ADDRESS ghost<std::size_t>                                         m_pushes;
+    CTRX_NO_UNIQUE_ADDRESS ghost<std::size_t>                                         m_pops;
+    CTRX_NO_UNIQUE_ADDRESS ghost<std::size_t, contract_type::invariant, level::audit> m_generation;
+};
+static_assert(sizeof(bounded_stack) == sizeof(std::array<int, 8>) + 3 * sizeof(std::size_t));
+
+constexpr auto push_pop() -> int
+{
+    bounded_stack s;
+    s.push(1);
+    s.push(2);
+    return s.pop();
+}
+static_assert(push_pop() == 2);
+
+TEST_CASE("ghost", "[ctrx]", runtime)
+{
+    SECTION("value")
+    {
+        ghost<int> g{41};
+        CTRX_GHOST(g, ++*g);
+        CHECK(g.get() == 42);
+        CHECK(g == 42);
+        g = 7;
+        CHECK(*g == 7);
+
+        // Discarded: the statement doesn't run, and the ghost has no value to refer to
+        ghost<int, contract_type::invariant, level::audit> audited{41};
+        bool                                               ran = false;
+        CTRX_GHOST(audited, ran = true, ++*audited);
+        CHECK(!ran);
+    }
+    SECTION("bookkeeping")
+    {
+        bounded_stack s;
+        s.push(1);
+        s.push(2);
+        CHECK(s.pop() == 2);
+        s.corrupt();
+        CHECK_THROWS_AS(ctrx::invariant_violation, s.check());
+    }
+}
@@ -0,0 +1,54 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#if !defined(NDEBUG)
+#define NDEBUG
+#endif
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE ASSERT
+#include "ctrx/ghost.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+using ctrx::contract_type;
+using ctrx::ghost;
+using ctrx::level;
+
+// ASSERT mode with NDEBUG never evaluates contracts, so ghosts are empty
+static_assert(!ghost<std::uint64_t, contract_type::assertion>::enabled);
+static_assert(std::is_empty_v<ghost<std::uint64_t, contract_type::assertion>>);
+
+// ... and live in a namespace of their own, apart from those of ASSERT mode without NDEBUG (ctrx_2222_2222)
+static_assert(std::is_same_v<ghost<std::uint64_t>, ctrx::ctrx_8888_2222::ghost<std::uint64_t>>);
+
+TEST_CASE("ghost (assert with NDEBUG)", "[ctrx]")
+{
+    ghost<std::uint64_t, contract_type::assertion> generation;
+    CTRX_GHOST(generation, ++*generation);
+    CTRX_ASSERT(generation == 1u);
+    CHECK(!decltype(generation)::enabled);
+}
+EVAL_TEST_CASE("ghost (assert with NDEBUG)");
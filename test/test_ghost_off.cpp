@@ -0,0 +1,59 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE OFF
+#include "ctrx/ghost.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+using ctrx::contract_type;
+using ctrx::ghost;
+using ctrx::level;
+
+// With contracts off, no ghost holds state, whatever its type and level
+static_assert(!ghost<std::uint64_t>::enabled);
+static_assert(!ghost<std::uint64_t, contract_type::precondition, level::o_1>::enabled);
+static_assert(std::is_empty_v<ghost<std::uint64_t>>);
+
+// A hot struct with ghost state, which takes no space at all
+struct cursor
+{
+    std::uint32_t                               head;
+    std::uint32_t                               tail;
+    CTRX_NO_UNIQUE_ADDRESS ghost<std::uint64_t> generation;
+};
+static_assert(sizeof(cursor) == 2 * sizeof(std::uint32_t));
+
+TEST_CASE("ghost (off)", "[ctrx]")
+{
+    // Neither the update nor the condition are evaluated, so the ghost's accessors needn't be defined
+    cursor c{1, 2, {}};
+    CTRX_GHOST(c.generation, ++*c.generation);
+    CTRX_INVARIANT(c.generation == c.head);
+    CHECK(c.head == 1);
+}
+EVAL_TEST_CASE("ghost (off)");
@@ -0,0 +1,139 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE THROW
+#include "ctrx/contracts.hpp"
+
+#include <stdexcept>
+
+class counter
+{
+  public:
+    explicit counter(int limit)
+        : m_limit(limit)
+    {
+        CTRX_INVARIANT_GUARD_ON_EXIT(valid());
+    }
+
+    void increment()
+    {
+        CTRX_INVARIANT_GUARD(valid(), default, "value must stay within limit");
+        ++m_value;
+    }
+
+    void increment_and_throw()
+    {
+        CTRX_INVARIANT_GUARD(valid());
+        ++m_value;
+        throw std::runtime_error("increment failed");
+    }
+
+    void corrupt() { m_value = -1; }
+
+    void sampled_increment()
+    {
+        CTRX_INVARIANT_GUARD_SAMPLED(4, counted_valid());
+        ++m_value;
+    }
+
+    [[nodiscard]] auto value() const -> int { return m_value; }
+    [[nodiscard]] auto checks() const -> int { return m_checks; }
+
+  private:
+    [[nodiscard]] auto valid() const -> bool { return m_value >= 0 && m_value <= m_limit; }
+    [[nodiscard]] auto counted_valid() -> bool
+    {
+        ++m_checks;
+        return valid();
+    }
+
+    int m_limit;
+    int m_value  = 0;
+    int m_checks = 0;
+};
+
+constexpr auto guarded_sum(int n) -> int
+{
+    int sum = 0;
+    CTRX_INVARIANT_GUARD(sum >= 0);
+    for (int i = 1; i <= n; ++i)
+        sum += i;
+    CTRX_INVARIANT(sum == n * (n + 1) / 2);
+    return sum;
+}
+
+TEST_CASE("invariant", "[ctrx]", runtime)
+{
+    SECTION("checked on exit")
+    {
+        counter c(1);
+        c.increment();
+        CHECK(c.value() == 1);
+        CHECK_THROWS_AS(ctrx::invariant_violation, c.increment());
+    }
+    SECTION("checked on entry")
+    {
+        counter c(1);
+        c.corrupt();
+        CHECK_THROWS_AS(ctrx::invariant_violation, c.increment());
+        CHECK(c.value() == -1);
+    }
+    SECTION("checked only on exit")
+    {
+        CHECK_THROWS_AS(ctrx::invariant_violation, counter(-1));
+    }
+    SECTION("not checked while unwinding")
+    {
+        counter c(0);
+        CHECK_THROWS_AS(std::runtime_error, c.increment_and_throw());
+        CHECK(c.value() == 1);
+    }
+    SECTION("violation type")
+    {
+        try
+        {
+            CTRX_INVARIANT(false);
+            CHECK(false);
+        }
+        catch (ctrx::contract_violation const& e)
+        {
+            CHECK(e.type() == ctrx::contract_type::invariant);
+        }
+    }
+    SECTION("sampled")
+    {
+        counter c(100);
+        for (int i = 0; i < 8; ++i)
+            c.sampled_increment();
+        CHECK(c.value() == 8);
+        CHECK(c.checks() == 4); // Entry and exit of the first and fifth call
+    }
+}
+
+TEST_CASE("invariant (constexpr)", "[ctrx]", compiletime)
+{
+    CHECK(guarded_sum(4) == 10);
+}
@@ -0,0 +1,120 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE FUZZ
+#include "ctrx/contracts.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <regex>
+#include <string>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+
+#if __has_include(<sys/wait.h>)
+#include <sys/wait.h>
+#include <unistd.h>
+
+auto positive(int i) -> int
+{
+    CTRX_PRECONDITION(i > 0, default, "must be positive");
+    return i;
+}
+
+auto even(int i) -> int
+{
+    CTRX_PRECONDITION(i % 2 == 0);
+    return i;
+}
+
+auto read_file(std::string const& path) -> std::string
+{
+    std::ifstream in{path};
+    return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+// Runs f in a child process, returns whether it was aborted
+template<typename F>
+auto aborts(F f) -> bool
+{
+    pid_t const pid = ::fork();
+    if (pid == 0)
+    {
+        ctrx::set_crash_record_fd(-1);
+        f();
+        ::_exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+
+TEST_CASE("mode fuzz", "[ctrx]", runtime)
+{
+    std::string const sites = "ctrx-test-mode-fuzz-" + std::to_string(::getpid()) + ".sites";
+    std::remove(sites.c_str());
+    REQUIRE(::setenv(CTRX_CONFIG_FUZZ_SITES_ENV, sites.c_str(), 1) == 0);
+
+    SECTION("passing checks")
+    {
+        CHECK(positive(1) == 1);
+        CHECK(even(2) == 2);
+    }
+    SECTION("known sites are counted, new sites abort")
+    {
+        // The first violation of a site is recorded in the known sites file and aborts
+        CHECK(aborts([] { positive(0); }));
+        std::string const recorded = read_file(sites);
+        CAPTURE(recorded);
+        REQUIRE(std::regex_match(recorded, std::regex("^0x[0-9a-f]{16}\n$")));
+        auto const site = static_cast<ctrx::site_id_t>(std::strtoull(recorded.c_str(), nullptr, 16));
+
+        // Once the site is known, its violations are only counted (this process hasn't loaded the file yet)
+        positive(0);
+        positive(-1);
+        CHECK(ctrx::fuzz_hits(site) == 2);
+        CHECK(read_file(sites) == recorded);
+
+        // Other sites still abort
+        CHECK(aborts([] { even(1); }));
+        CHECK(read_file(sites).size() == 2 * recorded.size());
+    }
+
+    std::remove(sites.c_str());
+    ::unsetenv(CTRX_CONFIG_FUZZ_SITES_ENV);
+}
+#endif
+
+TEST_CASE("mode fuzz (constexpr)", "[ctrx]", compiletime)
+{
+    CTRX_PRECONDITION(true);
+    CTRX_POSTCONDITION(true);
+    CTRX_ASSERT(true);
+    CTRX_ASSERTS(true, true);
+}
+EVAL_TEST_CASE("mode fuzz (constexpr)");
@@ -0,0 +1,87 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE FUZZ
+#include "ctrx/contracts.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// Decoder for a stream of tag-length-value records with varint lengths; its contracts are the fuzzing oracle
+struct record
+{
+    std::uint8_t                   tag;
+    std::span<std::uint8_t const> value;
+};
+
+auto decode_varint(std::span<std::uint8_t const>& input) -> std::optional<std::uint32_t>
+{
+    std::uint32_t value    = 0;
+    std::size_t   consumed = 0;
+    for (; consumed < input.size() && consumed < 5; ++consumed)
+    {
+        value |= static_cast<std::uint32_t>(input[consumed] & 0x7fu) << (7 * consumed);
+        if ((input[consumed] & 0x80u) == 0)
+        {
+            input = input.subspan(consumed + 1);
+            CTRX_POSTCONDITION(consumed < 5);
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+auto decode(std::span<std::uint8_t const> input) -> std::vector<record>
+{
+    std::size_t const   input_size = input.size();
+    std::vector<record> records;
+    while (!input.empty())
+    {
+        std::uint8_t const tag = input[0];
+        input                  = input.subspan(1);
+        auto const length      = decode_varint(input);
+        if (!length || *length > input.size())
+            break;
+        CTRX_ASSERT(*length <= input.size());
+        records.push_back({tag, input.first(*length)});
+        input = input.subspan(*length);
+    }
+
+    std::size_t decoded = 0;
+    for (auto const& r : records)
+        decoded += r.value.size();
+    CTRX_POSTCONDITION(decoded + records.size() <= input_size);
+    return records;
+}
+
+extern "C" auto LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size) -> int
+{
+    CTRX_PRECONDITION(data != nullptr || size == 0);
+    (void)decode({data, size});
+    return 0;
+}
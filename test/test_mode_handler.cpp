@@ -26,6 +26,12 @@
 #undef CTRX_CONFIG_MODE
 #define CTRX_CONFIG_MODE HANDLER
 #include "ctrx/contracts.hpp"
+#include "ctrx/validated.hpp"
+
+#if __has_include(<sys/wait.h>)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 std::string pre_msg    = "";
 std::string post_msg   = "";
@@ -46,6 +52,8 @@ void handle_contract_violation(contract_type t, std::string_view s, std::source_
     case contract_type::assertion:
         assert_msg = s;
         break;
+    case contract_type::invariant:
+        break;
     }
 }
 } // namespace ctrx
@@ -56,6 +64,20 @@ auto throws() -> bool
     return true;
 }
 
+// Conditions that cannot bind to a reference
+struct flags
+{
+    bool enabled : 1;
+    bool visible : 1;
+};
+#pragma pack(push, 1)
+struct packed
+{
+    char tag;
+    int  value;
+};
+#pragma pack(pop)
+
 TEST_CASE("mode: handler", "[ctrx]", runtime)
 {
     SECTION("pre")
@@ -114,6 +136,54 @@ TEST_CASE("mode: handler", "[ctrx]", runtime)
     }
 }
 
+TEST_CASE("mode: handler (bit-field and packed conditions)", "[ctrx]", runtime)
+{
+    flags  f{.enabled = true, .visible = false};
+    packed p{.tag = 'p', .value = 0};
+    int    result = 1;
+
+    assert_msg = "";
+    CTRX_ASSERT(f.enabled);
+    CHECK(assert_msg == "");
+    CTRX_ASSERT(f.visible);
+    CHECK(assert_msg == "f.visible");
+    assert_msg = "";
+    CTRX_ASSERT(p.tag);
+    CHECK(assert_msg == "");
+    CTRX_ASSERT(p.value);
+    CHECK(assert_msg == "p.value");
+    assert_msg = "";
+    CTRX_ASSERT(result == 1);
+    CHECK(assert_msg == "");
+    CTRX_ASSERT(result == 2);
+    CHECK(assert_msg == "result == 2");
+}
+
+struct positive
+{
+    constexpr auto operator()(int i) const -> bool { return i > 0; }
+};
+
+TEST_CASE("mode: handler (validated)", "[ctrx]", runtime)
+{
+    pre_msg = "";
+    CHECK(*ctrx::validate<positive>(1) == 1);
+    CHECK(pre_msg == "");
+#if __has_include(<sys/wait.h>)
+    // The handler returns, but no proof of a violated predicate may be created
+    pid_t const pid = ::fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        static_cast<void>(ctrx::validate<positive>(0));
+        ::_exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    CHECK(WIFSIGNALED(status));
+#endif
+}
+
 TEST_CASE("mode: handler (constexpr)", "[ctrx]", compiletime)
 {
     // Can't test negative case since that would be a compile error
@@ -50,12 +50,65 @@ void failure_with_exception()
     CTRX_ASSERT(throws());
 }
 
+// Conditions that cannot bind to a reference
+struct flags
+{
+    bool enabled : 1;
+    bool visible : 1;
+};
+#pragma pack(push, 1)
+struct packed
+{
+    char tag;
+    int  value;
+};
+#pragma pack(pop)
+
+void check_flag(flags f)
+{
+    CTRX_ASSERT(f.visible);
+}
+void check_packed(packed p)
+{
+    CTRX_ASSERT(p.value);
+}
+void check_named_result(int result)
+{
+    CTRX_ASSERT(result == 1);
+}
+
 TEST_CASE("mode: throw", "[ctrx]", runtime)
 {
     CHECK_THROWS_AS(ctrx::precondition_violation, precondition_failure());
     CHECK_THROWS_AS(ctrx::postcondition_violation, postcondition_failure());
     CHECK_THROWS_AS(ctrx::assertion_violation, assertion_failure());
 
+    auto const type_of = [](auto failure)
+    {
+        try
+        {
+            failure();
+        }
+        catch (ctrx::contract_violation const& e)
+        {
+            return e.type();
+        }
+        return ctrx::contract_type::invariant;
+    };
+    CHECK(type_of(precondition_failure) == ctrx::contract_type::precondition);
+    CHECK(type_of(postcondition_failure) == ctrx::contract_type::postcondition);
+    CHECK(type_of(assertion_failure) == ctrx::contract_type::assertion);
+
+    // Without CTRX_CONFIG_CAPTURE_STACKTRACE, the trace is still part of the exception, but stays empty
+    try
+    {
+        precondition_failure();
+    }
+    catch (ctrx::contract_violation const& e)
+    {
+        CHECK(e.stacktrace().empty());
+    }
+
     try
     {
         failure_with_exception();
@@ -69,6 +122,16 @@ TEST_CASE("mode: throw", "[ctrx]", runtime)
     }
 }
 
+TEST_CASE("mode: throw (bit-field and packed conditions)", "[ctrx]", runtime)
+{
+    CHECK_NOTHROW(check_flag({.enabled = false, .visible = true}));
+    CHECK_THROWS_AS(ctrx::assertion_violation, check_flag({.enabled = true, .visible = false}));
+    CHECK_NOTHROW(check_packed({.tag = 'p', .value = 1}));
+    CHECK_THROWS_AS(ctrx::assertion_violation, check_packed({.tag = 'p', .value = 0}));
+    CHECK_NOTHROW(check_named_result(1));
+    CHECK_THROWS_AS(ctrx::assertion_violation, check_named_result(2));
+}
+
 TEST_CASE("mode: throw (constexpr)", "[ctrx]", compiletime)
 {
     // Can't test negative case since that would be a compile error
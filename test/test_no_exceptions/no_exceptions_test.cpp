@@ -0,0 +1,77 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE HANDLER
+#include "ctrx/contracts.hpp"
+
+#include <string>
+
+#include <cstdio>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#error "This test must be compiled without exception support"
+#endif
+
+std::string last_msg;
+int         violations = 0;
+
+namespace ctrx
+{
+void handle_contract_violation(contract_type, std::string_view s, std::source_location const&)
+{
+    last_msg = s;
+    ++violations;
+}
+} // namespace ctrx
+
+auto checked_div(int a, int b) -> int
+{
+    CTRX_PRECONDITION(b != 0);
+    return b == 0 ? 0 : a / b;
+}
+
+auto expect(bool condition, char const* what) -> bool
+{
+    if (!condition)
+        std::printf("FAILED: %s\n", what);
+    return condition;
+}
+
+auto main() -> int
+{
+    bool ok = true;
+
+    ok &= expect(checked_div(4, 2) == 2, "passing precondition");
+    ok &= expect(violations == 0, "no violation reported");
+
+    checked_div(4, 0);
+    ok &= expect(violations == 1, "violation reported");
+    ok &= expect(last_msg == "b != 0", "violation message");
+
+    CTRX_ASSERTS(true, 1 + 1 == 3);
+    ok &= expect(violations == 2, "batched violation reported");
+    ok &= expect(last_msg == "1 + 1 == 3", "batched violation message");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE HANDLER
+#include "ctrx/contracts.hpp"
+
+#include <cstdlib>
+
+namespace ctrx
+{
+void handle_contract_violation(contract_type, std::string_view, std::source_location const&)
+{
+    std::abort();
+}
+} // namespace ctrx
+
+auto clamp_index(int i, int n) -> int
+{
+    CTRX_PRECONDITION(n > 0);
+    int const r = i < 0 ? 0 : (i >= n ? n - 1 : i);
+    CTRX_POSTCONDITION(r >= 0 && r < n);
+    return r;
+}
+
+auto sum(int const* values, int n) -> int
+{
+    CTRX_PRECONDITIONS(values != nullptr, n >= 0);
+    int s = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        CTRX_ASSERT(values[i] >= 0, default, "values must not be negative");
+        s += values[i];
+    }
+    return s;
+}
+
+auto main(int argc, char**) -> int
+{
+    int const values[] = {1, 2, 3};
+    return sum(values, clamp_index(argc, 3)) == 0 ? 1 : 0;
+}
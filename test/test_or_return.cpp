@@ -0,0 +1,109 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/contracts.hpp"
+#include "ctrx/violation_info.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <stdexcept>
+#include <string_view>
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+enum class error
+{
+    none,
+    negative,
+    too_large,
+    invalid,
+};
+
+constexpr auto validate_percentage(int value) -> error
+{
+    CTRX_PRECONDITION_OR_RETURN(error::negative, value >= 0);
+    CTRX_PRECONDITION_OR_RETURN(error::too_large, value <= 100, default, "percentages are at most 100");
+    return error::none;
+}
+
+auto throwing_check(int) -> bool
+{
+    throw std::runtime_error("no");
+}
+
+auto validate_throwing(int value) -> error
+{
+    CTRX_PRECONDITION_OR_RETURN(error::invalid, throwing_check(value));
+    return error::none;
+}
+
+// Not checked, as audit preconditions are turned off
+auto validate_audit(int value) -> error
+{
+    CTRX_PRECONDITION_OR_RETURN(error::negative, value >= 0, audit);
+    return error::none;
+}
+
+TEST_CASE("precondition or return", "[ctrx]", runtime)
+{
+    CHECK(validate_percentage(50) == error::none);
+    CHECK(validate_percentage(-1) == error::negative);
+    CHECK(validate_percentage(101) == error::too_large);
+    CHECK(validate_throwing(1) == error::invalid);
+    CHECK(validate_audit(-1) == error::none);
+}
+
+TEST_CASE("precondition or return (constexpr)", "[ctrx]", compiletime)
+{
+    CHECK(validate_percentage(100) == error::none);
+    CHECK(validate_percentage(-5) == error::negative);
+}
+EVAL_TEST_CASE("precondition or return (constexpr)");
+
+#if defined(__cpp_lib_expected)
+auto parse_digit(char c) -> std::expected<int, ctrx::violation_info>
+{
+    CTRX_PRECONDITION_OR_UNEXPECTED(c >= '0' && c <= '9', default, "not a digit");
+    return c - '0';
+}
+constexpr unsigned parse_digit_line = __LINE__ - 3;
+
+TEST_CASE("precondition or unexpected", "[ctrx]", runtime)
+{
+    using namespace std::string_view_literals;
+
+    CHECK(parse_digit('7') == 7);
+
+    auto const result = parse_digit('x');
+    REQUIRE(!result.has_value());
+    auto const& info = result.error();
+    CHECK(info.type == ctrx::contract_type::precondition);
+    CHECK(info.condition == "c >= '0' && c <= '9'"sv);
+    CHECK(info.message == "not a digit"sv);
+    CHECK(info.source_location.line() == parse_digit_line);
+    CHECK(info.site_id
+          == ctrx::detail::hash_site(__FILE__, parse_digit_line, R"(c >= '0' && c <= '9', default, "not a digit")", 0));
+}
+#endif
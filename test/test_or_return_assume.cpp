@@ -0,0 +1,55 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE ASSUME
+#include "ctrx/contracts.hpp"
+
+enum class error
+{
+    none,
+    negative,
+};
+
+// Error-return contracts are checked even though other contracts are assumed
+constexpr auto validate_positive(int value) -> error
+{
+    CTRX_PRECONDITION_OR_RETURN(error::negative, value > 0);
+    return error::none;
+}
+
+TEST_CASE("precondition or return (assume)", "[ctrx]", runtime)
+{
+    CHECK(validate_positive(1) == error::none);
+    CHECK(validate_positive(0) == error::negative);
+    CHECK(validate_positive(-1) == error::negative);
+}
+
+TEST_CASE("precondition or return (assume, constexpr)", "[ctrx]", compiletime)
+{
+    CHECK(validate_positive(1) == error::none);
+    CHECK(validate_positive(-1) == error::negative);
+}
+EVAL_TEST_CASE("precondition or return (assume, constexpr)");
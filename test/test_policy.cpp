@@ -0,0 +1,104 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_LEVEL AUDIT
+#define CTRX_CONFIG_POLICY
+#include "ctrx/contracts.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <vector>
+
+using ctrx::detail::path_match;
+
+static_assert(path_match("*", "/home/ci/src/match/book.cpp"));
+static_assert(path_match("src/match/*", "/home/ci/src/match/book.cpp"));
+static_assert(path_match("src/match/*", "src\\match\\book.cpp"));
+static_assert(path_match("match/b??k.cpp", "/home/ci/src/match/book.cpp"));
+static_assert(!path_match("src/match/*", "/home/ci/src/matching/book.cpp"));
+static_assert(!path_match("atch/*", "/home/ci/src/match/book.cpp"));
+static_assert(!path_match("*.hpp", "/home/ci/src/match/book.cpp"));
+
+// Contract sites in other (pretend) files, whose policies differ
+#line 1 "src/match/engine.cpp"
+auto match(int quantity) -> int
+{
+    CTRX_PRECONDITION(quantity > 0);
+    return quantity;
+}
+#line 1 "src/risk/limits.cpp"
+auto check_limit(int exposure) -> int
+{
+    CTRX_PRECONDITION(exposure < 100);
+    CTRX_ASSERT(exposure != 42, o_n);
+    return exposure;
+}
+#line 1 "src/feed/decode.cpp"
+auto decode(int message) -> int
+{
+    CTRX_PRECONDITIONS(message >= 0, message < 256);
+    CTRX_ASSERT(message != 7, audit);
+    return message;
+}
+#line 46 "test_policy.cpp"
+
+TEST_CASE("policy", "[ctrx]", runtime)
+{
+    ctrx::set_policy("src/match/*:off; src/risk/*:throw,o_1 # incident 1234\n*:audit");
+
+    CHECK(match(-1) == -1);
+    CHECK_THROWS_AS(ctrx::precondition_violation, check_limit(100));
+    CHECK(check_limit(42) == 42);
+    CHECK_THROWS_AS(ctrx::precondition_violation, decode(-1));
+    CHECK_THROWS_AS(ctrx::precondition_violation, decode(256));
+    CHECK_THROWS_AS(ctrx::assertion_violation, decode(7));
+
+    // Decisions are cached per site: a new policy only applies to sites that haven't been executed yet
+    ctrx::set_policy("*:off");
+    CHECK_THROWS_AS(ctrx::assertion_violation, decode(7));
+}
+
+TEST_CASE("policy parsing", "[ctrx]", runtime)
+{
+    std::vector<ctrx::detail::policy_rule> rules;
+    ctrx::detail::parse_policy("# comment\n a/* : OFF ;b/*:o_n,default\n\nc/*:bogus;:off;d/*;e/*:\n*:Throw", rules);
+    REQUIRE(rules.size() == 3);
+    CHECK(rules[0].pattern == "a/*");
+    CHECK(rules[0].max_tier == 0);
+    CHECK(rules[1].pattern == "b/*");
+    CHECK(rules[1].max_tier == 2);
+    CHECK(rules[2].pattern == "*");
+    CHECK(rules[2].max_tier == ctrx::detail::policy_all);
+}
+
+constexpr auto half(int i) -> int
+{
+    CTRX_PRECONDITION(i % 2 == 0);
+    return i / 2;
+}
+
+TEST_CASE("policy (constexpr)", "[ctrx]", compiletime)
+{
+    CHECK(half(4) == 2);
+}
+EVAL_TEST_CASE("policy (constexpr)");
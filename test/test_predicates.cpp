@@ -0,0 +1,142 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/contracts.hpp"
+#include "ctrx/predicates.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+auto element(std::vector<int> const& v, int i) -> int
+{
+    CTRX_PRECONDITION(ctrx::valid_index(i, v));
+    return v[static_cast<std::size_t>(i)];
+}
+
+auto percentage(int p) -> int
+{
+    CTRX_PRECONDITION(ctrx::in_range(p, 0, 100), default, "percentage");
+    return p;
+}
+
+auto what_of(auto f) -> std::string
+{
+    try
+    {
+        f();
+    }
+    catch (ctrx::contract_violation const& e)
+    {
+        return e.what();
+    }
+    return "";
+}
+
+TEST_CASE("predicates", "[ctrx]", runtime)
+{
+    SECTION("in_range")
+    {
+        CHECK(ctrx::in_range(0, 0, 10));
+        CHECK(ctrx::in_range(10, 0, 10));
+        CHECK(!ctrx::in_range(11, 0, 10));
+        CHECK(!ctrx::in_range(-1, 0, 10));
+        CHECK(ctrx::in_range(-5, -10, -1));
+        CHECK(!ctrx::in_range(std::numeric_limits<int>::min(), -1, std::numeric_limits<int>::max()));
+        CHECK(ctrx::in_range(std::numeric_limits<int>::min(), std::numeric_limits<int>::min(), 0));
+        CHECK(ctrx::in_range(0.5, 0.0, 1.0));
+        CHECK(!ctrx::in_range(std::nan(""), 0.0, 1.0));
+        CHECK(ctrx::in_range(11, 0, 10).describe() == "value 11 is not in [0, 10]");
+    }
+    SECTION("valid_index")
+    {
+        std::array<int, 3> const a{};
+        CHECK(ctrx::valid_index(0, 3));
+        CHECK(ctrx::valid_index(2u, a));
+        CHECK(!ctrx::valid_index(3, a));
+        CHECK(!ctrx::valid_index(-1, std::size_t{3}));
+        CHECK(!ctrx::valid_index(0, 0));
+        CHECK(ctrx::valid_index(-1, a).describe() == "index -1 is out of range for size 3");
+    }
+    SECTION("not_null")
+    {
+        int                        i = 0;
+        std::unique_ptr<int> const p;
+        CHECK(ctrx::not_null(&i));
+        CHECK(!ctrx::not_null(static_cast<int*>(nullptr)));
+        CHECK(!ctrx::not_null(p));
+        CHECK(ctrx::not_null(p).describe() == "pointer is null");
+    }
+    SECTION("is_aligned")
+    {
+        alignas(16) std::array<char, 32> buffer{};
+        CHECK(ctrx::is_aligned<16>(buffer.data()));
+        CHECK(ctrx::is_aligned<1>(buffer.data() + 1));
+        CHECK(!ctrx::is_aligned<2>(buffer.data() + 1));
+        CHECK(ctrx::is_aligned<2>(buffer.data() + 1).describe().ends_with(" is not aligned to 2"));
+    }
+    SECTION("finite")
+    {
+        CHECK(ctrx::finite(1.0));
+        CHECK(ctrx::finite(std::numeric_limits<float>::max()));
+        CHECK(!ctrx::finite(std::numeric_limits<double>::infinity()));
+        CHECK(!ctrx::finite(-std::numeric_limits<double>::infinity()));
+        CHECK(!ctrx::finite(std::numeric_limits<double>::quiet_NaN()));
+        CHECK(ctrx::finite(std::numeric_limits<double>::infinity()).describe() == "value inf is not finite");
+    }
+    SECTION("non_overlapping")
+    {
+        std::array<int, 8> const a{};
+        CHECK(ctrx::non_overlapping(a.data(), 4, a.data() + 4, 4));
+        CHECK(!ctrx::non_overlapping(a.data(), 5, a.data() + 4, 4));
+        CHECK(!ctrx::non_overlapping(a.data() + 4, 4, a.data(), 5));
+        CHECK(ctrx::non_overlapping(std::vector<int>(4), a));
+        CHECK(!ctrx::non_overlapping(a, a));
+        CHECK(ctrx::non_overlapping(a, a).describe().find(") overlaps with [") != std::string::npos);
+    }
+    SECTION("descriptions are reported")
+    {
+        std::vector<int> const v(3);
+        CHECK(what_of([&] { element(v, 3); }).find("ctrx::valid_index(i, v): index 3 is out of range for size 3")
+              != std::string::npos);
+        CHECK(what_of([] { percentage(101); }).find("(percentage): value 101 is not in [0, 100]") != std::string::npos);
+        CHECK(what_of([] { percentage(50); }).empty());
+    }
+}
+
+TEST_CASE("predicates (constexpr)", "[ctrx]", compiletime)
+{
+    constexpr std::array<int, 3> a{};
+    CTRX_PRECONDITION(ctrx::in_range(5, 0, 10));
+    CTRX_PRECONDITION(ctrx::valid_index(2, a));
+    CTRX_PRECONDITION(ctrx::not_null(a.data()));
+    CTRX_PRECONDITION(ctrx::finite(1.0));
+    CTRX_PRECONDITIONS(ctrx::in_range(5, 0, 10), ctrx::valid_index(0, 1));
+}
+EVAL_TEST_CASE("predicates (constexpr)");
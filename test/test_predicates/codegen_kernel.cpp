@@ -0,0 +1,95 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/predicates.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Every predicate (ctrx_<name>) next to its handwritten form (manual_<name>), whose instruction counts are compared
+
+extern "C" auto ctrx_in_range(int value) -> bool
+{
+    return ctrx::in_range(value, 0, 100);
+}
+extern "C" auto manual_in_range(int value) -> bool
+{
+    return value >= 0 && value <= 100;
+}
+
+extern "C" auto ctrx_in_range_bounds(int value, int min, int max) -> bool
+{
+    return ctrx::in_range(value, min, max);
+}
+extern "C" auto manual_in_range_bounds(int value, int min, int max) -> bool
+{
+    return min <= value && value <= max;
+}
+
+extern "C" auto ctrx_valid_index(std::ptrdiff_t index, std::size_t size) -> bool
+{
+    return ctrx::valid_index(index, size);
+}
+extern "C" auto manual_valid_index(std::ptrdiff_t index, std::size_t size) -> bool
+{
+    return index >= 0 && static_cast<std::size_t>(index) < size;
+}
+
+extern "C" auto ctrx_not_null(int const* pointer) -> bool
+{
+    return ctrx::not_null(pointer);
+}
+extern "C" auto manual_not_null(int const* pointer) -> bool
+{
+    return pointer != nullptr;
+}
+
+extern "C" auto ctrx_is_aligned(void const* pointer) -> bool
+{
+    return ctrx::is_aligned<16>(static_cast<char const*>(pointer));
+}
+extern "C" auto manual_is_aligned(void const* pointer) -> bool
+{
+    return (reinterpret_cast<std::uintptr_t>(pointer) & 15u) == 0;
+}
+
+extern "C" auto ctrx_finite(double value) -> bool
+{
+    return ctrx::finite(value);
+}
+extern "C" auto manual_finite(double value) -> bool
+{
+    return std::isfinite(value);
+}
+
+extern "C" auto ctrx_non_overlapping(int const* first1, std::size_t count1, int const* first2, std::size_t count2)
+    -> bool
+{
+    return ctrx::non_overlapping(first1, count1, first2, count2);
+}
+extern "C" auto manual_non_overlapping(int const* first1, std::size_t count1, int const* first2, std::size_t count2)
+    -> bool
+{
+    return first1 + count1 <= first2 || first2 + count2 <= first1;
+}
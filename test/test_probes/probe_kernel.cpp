@@ -0,0 +1,43 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Contracts with SDT probes on every check and violation, whose notes are verified by check_probes.cmake
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE THROW
+#define CTRX_CONFIG_LEVEL AUDIT
+#define CTRX_CONFIG_PROBE_CHECKS
+#include "ctrx/contracts.hpp"
+
+auto divide(int dividend, int divisor) -> int
+{
+    CTRX_PRECONDITION(divisor != 0);
+    auto const quotient = dividend / divisor;
+    CTRX_POSTCONDITION(quotient * divisor <= dividend, audit);
+    return quotient;
+}
+
+auto main(int argc, char**) -> int
+{
+    CTRX_ASSERT(argc > 0, o_1);
+    return divide(argc, argc) - 1;
+}
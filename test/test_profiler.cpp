@@ -0,0 +1,197 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_LEVEL AUDIT
+#define CTRX_CONFIG_PROFILE
+#include "ctrx/contracts.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+auto is_sorted(std::vector<int> const& v) -> bool
+{
+    return std::is_sorted(v.begin(), v.end());
+}
+
+auto front(std::vector<int> const& v) -> int
+{
+    CTRX_PRECONDITION(!v.empty());
+    CTRX_PRECONDITION(is_sorted(v), audit);
+    return v.front();
+}
+
+auto front_or_zero(std::vector<int> const& v) -> int
+{
+    CTRX_PRECONDITION_OR_RETURN(0, !v.empty() && v.size() < 100);
+    return v.front();
+}
+
+auto positive(int i) -> int
+{
+    CTRX_PRECONDITION(i > 0);
+    return i;
+}
+
+auto find(std::vector<ctrx::profile_entry> const& entries, std::string_view condition) -> ctrx::profile_entry const*
+{
+    auto const iter = std::find_if(entries.begin(),
+                                   entries.end(),
+                                   [&](ctrx::profile_entry const& e) { return e.condition == condition; });
+    return iter == entries.end() ? nullptr : &*iter;
+}
+
+TEST_CASE("profiler", "[ctrx]", runtime)
+{
+    ctrx::reset_profile();
+
+    std::vector<int> const v(1000, 1);
+    auto const             worker = [&]
+    {
+        for (int i = 0; i < 10; ++i)
+            front(v);
+    };
+    std::thread t{worker};
+    worker();
+    worker();
+    t.join();
+
+    auto const entries = ctrx::profile_report();
+
+    auto const* empty_check = find(entries, "!v.empty()");
+    REQUIRE(empty_check != nullptr);
+    CHECK(empty_check->evaluations == 30);
+    CHECK(empty_check->type == ctrx::contract_type::precondition);
+    CHECK(empty_check->level == std::string_view{"DEFAULT"});
+    CHECK(empty_check->source_location.line() == 44);
+
+    auto const* sorted_check = find(entries, "is_sorted(v)");
+    REQUIRE(sorted_check != nullptr);
+    CHECK(sorted_check->evaluations == 30);
+    CHECK(sorted_check->level == std::string_view{"AUDIT"});
+
+    CHECK(std::is_sorted(entries.begin(),
+                         entries.end(),
+                         [](ctrx::profile_entry const& lhs, ctrx::profile_entry const& rhs)
+                         { return lhs.ticks > rhs.ticks; }));
+    CHECK(ctrx::profile_report(1).size() == 1);
+
+    ctrx::reset_profile();
+    CHECK(find(ctrx::profile_report(), "!v.empty()")->evaluations == 0);
+}
+
+TEST_CASE("profile recording", "[ctrx]", runtime)
+{
+    ctrx::reset_profile();
+
+    std::vector<int> const v(10, 1);
+    front(v);
+    try
+    {
+        front({});
+        CHECK(false);
+    }
+    catch (ctrx::precondition_violation const&)
+    {
+    }
+
+    auto const  entries     = ctrx::profile_report();
+    auto const* empty_check = find(entries, "!v.empty()");
+    REQUIRE(empty_check != nullptr);
+    CHECK(empty_check->evaluations == 2);
+    CHECK(empty_check->violations == 1);
+    CHECK(empty_check->site_id == ctrx::detail::hash_site(__FILE__, 44, "!v.empty()", 0));
+    CHECK(find(entries, "is_sorted(v)")->violations == 0);
+
+    std::ostringstream out;
+    ctrx::write_profile(out);
+    auto const line = std::string(ctrx::format_site_id(empty_check->site_id).data()) + "\t2\t1\t";
+    CHECK(out.str().starts_with("# site\tevaluations"));
+    CHECK(out.str().find("\n" + line) != std::string::npos);
+    CHECK(out.str().find("\tPRECONDITION\tDEFAULT\t") != std::string::npos);
+}
+
+TEST_CASE("profiler (error-return contracts)", "[ctrx]", runtime)
+{
+    ctrx::reset_profile();
+
+    std::vector<int> const v(10, 1);
+    CHECK(front_or_zero(v) == 1);
+    CHECK(front_or_zero({}) == 0);
+
+    auto const  entries = ctrx::profile_report();
+    auto const* entry   = find(entries, "!v.empty() && v.size() < 100");
+    REQUIRE(entry != nullptr);
+    CHECK(entry->evaluations == 2);
+    CHECK(entry->violations == 1);
+}
+
+// Runs last, as it fills the registry
+TEST_CASE("profiler (site limit)", "[ctrx]", runtime)
+{
+    using ctrx::detail::profile_site;
+
+    constexpr auto max_sites = ctrx::detail::profile_registry::max_sites;
+    static std::vector<std::string> const conditions = []
+    {
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < max_sites; ++i)
+            result.push_back("site " + std::to_string(i));
+        return result;
+    }();
+    std::vector<profile_site> sites(max_sites);
+
+    auto&               registry = ctrx::detail::profile_registry::instance();
+    std::uint_least32_t id       = 0;
+    std::size_t         i        = 0;
+    for (; i < max_sites && id != profile_site::unregistrable; ++i)
+        id = registry.register_site(sites[i],
+                                    {ctrx::contract_type::assertion,
+                                     0,
+                                     "DEFAULT",
+                                     conditions[i].c_str(),
+                                     std::source_location::current(),
+                                     0,
+                                     0,
+                                     0});
+    REQUIRE(id == profile_site::unregistrable);
+    CHECK(sites[i - 1].id.load() == profile_site::unregistrable);
+
+    // Sites that don't fit are still checked, but not profiled
+    CHECK(positive(1) == 1);
+    CHECK_THROWS_AS(ctrx::precondition_violation, positive(0));
+    CHECK(find(ctrx::profile_report(), "i > 0") == nullptr);
+}
+
+TEST_CASE("profiler (constexpr)", "[ctrx]", compiletime)
+{
+    CTRX_PRECONDITION(true);
+    CTRX_POSTCONDITION(true);
+    CTRX_ASSERT(true);
+}
+EVAL_TEST_CASE("profiler (constexpr)");
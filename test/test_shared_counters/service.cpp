@@ -0,0 +1,141 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// Checks contracts with shared counters, then runs ctrx-counters on its own segment (by pid, or by the name given) and
+// verifies the counts it prints. With "taken", another segment of that name exists already, as if another worker had
+// created it, and is left alone.
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE THROW
+#include "ctrx/contracts.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+auto checked_half(int n) -> int
+{
+    CTRX_PRECONDITION(n >= 0);
+    CTRX_ASSERT(n % 2 == 0, o_1);
+    return n / 2;
+}
+
+// Fields of the line ctrx-counters prints about the contract with the condition given
+auto find_site(std::string const& output, std::string const& condition) -> std::vector<std::string>
+{
+    std::istringstream lines{output};
+    for (std::string line; std::getline(lines, line);)
+    {
+        if (!line.ends_with(": " + condition))
+            continue;
+        std::istringstream       fields{line};
+        std::vector<std::string> result;
+        for (std::string field; fields >> field;)
+            result.push_back(field);
+        return result;
+    }
+    return {};
+}
+
+auto expect(bool condition, char const* what) -> bool
+{
+    if (!condition)
+        std::cerr << "failed: " << what << '\n';
+    return condition;
+}
+
+auto main(int argc, char** argv) -> int
+{
+    bool const  taken = argc > 2 && std::string(argv[2]) == "taken";
+    std::string other;
+    if (taken)
+    {
+        other = "/" + std::string(argv[1]);
+        ::shm_unlink(other.c_str()); // Left over by a failed run
+        int const fd = ::shm_open(other.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (!expect(fd >= 0 && ::ftruncate(fd, 4) == 0, "another segment is created"))
+            return 1;
+        ::close(fd);
+    }
+
+    // 100 evaluations of the precondition, 20 violations; 80 evaluations of the assertion, 40 violations
+    for (int n = -20; n < 80; ++n)
+    {
+        try
+        {
+            checked_half(n);
+        }
+        catch (ctrx::contract_violation const&)
+        {
+        }
+    }
+
+    std::string const pid    = std::to_string(::getpid());
+    std::string const target = argc > 1 ? std::string(argv[1]) + (taken ? "." + pid : "") : pid;
+    if (taken)
+    {
+        struct stat st{};
+        int const   fd = ::shm_open(other.c_str(), O_RDONLY, 0);
+        bool const  ok = expect(fd >= 0 && ::fstat(fd, &st) == 0 && st.st_size == 4, "the other segment is untouched");
+        if (fd >= 0)
+            ::close(fd);
+        ::shm_unlink(other.c_str());
+        if (!ok)
+            return 1;
+    }
+    if (!expect(ctrx::shared_counters_name() == (argc > 1 ? "/" + target : "/ctrx." + target), "segment name"))
+        return 1;
+
+    std::string const command = std::string(CTRX_TEST_COUNTERS_TOOL) + " -n 1 " + target;
+    std::FILE*        pipe    = ::popen(command.c_str(), "r");
+    if (pipe == nullptr)
+        return 1;
+    std::string output;
+    char        buffer[256];
+    while (std::fgets(buffer, sizeof(buffer), pipe) != nullptr)
+        output += buffer;
+    if (!expect(::pclose(pipe) == 0, "ctrx-counters succeeds"))
+        return 1;
+    std::cout << output;
+
+    // violations/s, evaluations/s, violations, evaluations, site, type, level, location...
+    auto const precondition = find_site(output, "n >= 0");
+    auto const assertion    = find_site(output, "n % 2 == 0");
+    bool       ok           = expect(precondition.size() >= 8 && assertion.size() >= 8, "both sites are listed");
+    if (!ok)
+        return 1;
+    ok &= expect(precondition[2] == "20" && precondition[3] == "100", "precondition counts");
+    ok &= expect(precondition[5] == "PRECONDITION" && precondition[6] == "DEFAULT", "precondition type and level");
+    ok &= expect(assertion[2] == "40" && assertion[3] == "80", "assertion counts");
+    ok &= expect(assertion[5] == "ASSERTION" && assertion[6] == "O_1", "assertion type and level");
+    ok &= expect(output.find("n % 2 == 0") < output.find("n >= 0"), "sites are ordered by violation rate");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/cost.hpp"
+#include "ctrx/snapshot.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+static_assert(ctrx::snapshottable<std::vector<double>>);
+static_assert(ctrx::snapshottable<std::array<int, 4>>);
+static_assert(ctrx::snapshottable<int[4]>);
+static_assert(!ctrx::snapshottable<std::vector<std::vector<int>>>);
+
+struct quote
+{
+    int    bid;
+    int    ask;
+    double size;
+};
+
+// Reads the table, and mutates it if asked to
+constexpr auto sum(std::vector<int>& table, bool mutate) -> int
+{
+    CTRX_SNAPSHOT(table);
+    int total = 0;
+    for (int value : table)
+        total += value;
+    if (mutate)
+        table.back() = -table.back();
+    CTRX_ASSERT_UNCHANGED(table);
+    return total;
+}
+
+TEST_CASE("crc32c", "[ctrx]", runtime)
+{
+    CHECK(ctrx::detail::crc32c("123456789", 9) == 0xe3069283u);
+    CHECK(ctrx::detail::crc32c("", 0) == 0u);
+
+    // The interleaved hardware implementation only kicks in for large buffers
+    std::vector<unsigned char> bytes(50'000);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<unsigned char>(i * 31 + i / 7);
+    constexpr std::size_t sizes[] = {0, 1, 8, 4095, 12'288, 12'289, 50'000};
+    for (std::size_t size : sizes)
+    {
+        CAPTURE(size);
+        CHECK(ctrx::detail::crc32c(bytes.data(), size)
+              == ~ctrx::detail::crc32c_portable(~std::uint32_t{0}, bytes.data(), size));
+    }
+}
+
+TEST_CASE("snapshot", "[ctrx]", runtime)
+{
+    std::vector<int> table{1, 2, 3, 4};
+    CHECK(sum(table, false) == 10);
+    CHECK_THROWS_AS(ctrx::assertion_violation, sum(table, true));
+
+    try
+    {
+        sum(table, true);
+        CHECK(false);
+    }
+    catch (ctrx::assertion_violation const& e)
+    {
+        CAPTURE(e.what());
+        CHECK(std::string_view{e.what()}.find("table changed since its snapshot") != std::string_view::npos);
+        CHECK(std::string_view{e.what()}.find("at the snapshot") != std::string_view::npos);
+    }
+
+    quote q{100, 101, 2.5};
+    CTRX_SNAPSHOT(q, o_1);
+    q.size = 3.0;
+    CHECK_THROWS_AS(ctrx::assertion_violation, [&] { CTRX_ASSERT_UNCHANGED(q, o_1); }());
+
+    // Constant evaluation takes the bytes one element at a time, to the same checksum
+    constexpr auto checksum = ctrx::snapshot{std::array{1, 2, 3}}.checksum();
+    std::array     runtime{1, 2, 3};
+    CHECK(ctrx::snapshot{runtime}.checksum() == checksum);
+
+    ctrx::snapshot const not_taken;
+    CHECK(!not_taken.taken());
+    CHECK(not_taken.unchanged(table));
+}
+
+TEST_CASE("snapshot above the runtime maximum cost", "[ctrx]", runtime)
+{
+    std::array<int, 3> data{1, 2, 3};
+    auto const         mutate = [&data]
+    {
+        CTRX_SNAPSHOT(data, o_log_n);
+        ++data[0];
+        CTRX_ASSERT_UNCHANGED(data, o_log_n);
+    };
+    CHECK_THROWS_AS(ctrx::assertion_violation, mutate());
+
+    // Neither taken nor checked
+    ctrx::thread_policy const policy{ctrx::cost::o_1};
+    mutate();
+}
+
+TEST_CASE("snapshot (constexpr)", "[ctrx]", compiletime)
+{
+    std::vector<int> table{5, 6, 7};
+    CHECK(sum(table, false) == 18);
+
+    int const values[] = {1, 2, 3};
+    CHECK(ctrx::snapshot{values}.checksum() == ctrx::snapshot{std::array{1, 2, 3}}.checksum());
+}
+EVAL_TEST_CASE("snapshot (constexpr)");
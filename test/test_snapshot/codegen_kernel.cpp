@@ -0,0 +1,69 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE CTRX_CODEGEN_MODE
+#include "ctrx/snapshot.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Functions with snapshot contracts (ctrx_<name>) next to the same functions without them (manual_<name>), whose
+// instruction counts are compared. Where the contracts aren't checked, neither storage nor checksum may remain: in
+// the modes that don't check, and for levels above the configured one in those that do.
+
+#if CTRX_DETAIL_MODE_NUM(ASSERTION) != CTRX_DETAIL_MODE_NUM_THROW
+extern "C" auto ctrx_sum(std::vector<int> const& table) -> long
+{
+    CTRX_SNAPSHOT(table);
+    long sum = 0;
+    for (int value : table)
+        sum += value;
+    CTRX_ASSERT_UNCHANGED(table);
+    return sum;
+}
+extern "C" auto manual_sum(std::vector<int> const& table) -> long
+{
+    long sum = 0;
+    for (int value : table)
+        sum += value;
+    return sum;
+}
+#endif
+
+extern "C" auto ctrx_sum_o_n(std::vector<int> const& table) -> long
+{
+    CTRX_SNAPSHOT(table, o_n);
+    long sum = 0;
+    for (int value : table)
+        sum += value;
+    CTRX_ASSERT_UNCHANGED(table, o_n);
+    return sum;
+}
+extern "C" auto manual_sum_o_n(std::vector<int> const& table) -> long
+{
+    long sum = 0;
+    for (int value : table)
+        sum += value;
+    return sum;
+}
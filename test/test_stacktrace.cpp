@@ -0,0 +1,83 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE THROW
+#define CTRX_CONFIG_MODE_ASSERTION HANDLER
+#define CTRX_CONFIG_CAPTURE_STACKTRACE
+#include "ctrx/contracts.hpp"
+
+ctrx::raw_stacktrace handler_trace;
+
+namespace ctrx
+{
+void handle_contract_violation(contract_type, std::string_view, std::source_location const&, raw_stacktrace const& t)
+{
+    handler_trace = t;
+}
+} // namespace ctrx
+
+CTRX_DETAIL_NOINLINE void precondition_failure()
+{
+    CTRX_PRECONDITION(false);
+}
+CTRX_DETAIL_NOINLINE void assertion_failure()
+{
+    CTRX_ASSERT(false);
+}
+
+TEST_CASE("stacktrace", "[ctrx]", runtime)
+{
+    SECTION("capture")
+    {
+        auto const trace = ctrx::raw_stacktrace::capture();
+        CHECK(!trace.empty());
+        CHECK(trace.size() <= CTRX_CONFIG_STACKTRACE_DEPTH);
+        CHECK(trace.to_string().starts_with("#0 0x"));
+        CHECK(ctrx::raw_stacktrace::capture(0, 1).size() == 1);
+    }
+    SECTION("attached to exception")
+    {
+        try
+        {
+            precondition_failure();
+            CHECK(false);
+        }
+        catch (ctrx::precondition_violation const& e)
+        {
+            CHECK(e.stacktrace().size() >= 2);
+        }
+    }
+    SECTION("passed to handler")
+    {
+        handler_trace = {};
+        assertion_failure();
+        CHECK(handler_trace.size() >= 2);
+    }
+    SECTION("load map")
+    {
+        CHECK(!ctrx::load_map().empty());
+    }
+}
@@ -0,0 +1,197 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <bugspray/bugspray.hpp>
+
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE THROW
+#define CTRX_CONFIG_MODE_ASSERTION HANDLER
+#define CTRX_CONFIG_STRIP_STRINGS
+#include "ctrx/contracts.hpp"
+#include "ctrx/site_map.hpp"
+#include "ctrx/snapshot.hpp"
+
+#include <sstream>
+#include <string>
+
+std::string          handler_message;
+std::source_location handler_sloc;
+
+namespace ctrx
+{
+void handle_contract_violation(contract_type, std::string_view msg, std::source_location const& sloc)
+{
+    handler_message = msg;
+    handler_sloc    = sloc;
+}
+} // namespace ctrx
+
+auto check_positive(int n) -> int
+{
+    CTRX_PRECONDITION(n > 0, default, "n must be positive");
+    return n;
+}
+constexpr unsigned check_positive_line = __LINE__ - 3;
+
+auto check_range(int n) -> int
+{
+    CTRX_PRECONDITIONS(n > 0, n < 10);
+    CTRX_ASSERT(n != 5);
+    return n;
+}
+constexpr unsigned check_range_line = __LINE__ - 4;
+
+auto check_non_negative(int n) -> int
+{
+    CTRX_POSTCONDITION(n >= 0);
+    return n;
+}
+
+void mutate(int (&table)[3])
+{
+    CTRX_SNAPSHOT(table);
+    ++table[0];
+    CTRX_ASSERT_UNCHANGED(table);
+}
+constexpr unsigned mutate_line = __LINE__ - 4;
+
+auto seven_or_zero(int n) -> int
+{
+    CTRX_PRECONDITION_OR_RETURN(0, n == 7, o_1);
+    return n;
+}
+constexpr unsigned seven_or_zero_line = __LINE__ - 3;
+
+TEST_CASE("strip strings", "[ctrx]", runtime)
+{
+    auto const positive_text = R"(n > 0, default, "n must be positive")";
+    auto const positive_id   = ctrx::detail::hash_site(__FILE__, check_positive_line, positive_text, 0);
+    auto const range_id      = ctrx::detail::hash_site(__FILE__, check_range_line, "n > 0, n < 10", 1);
+    auto const assert_id     = ctrx::detail::hash_site(__FILE__, check_range_line + 1, "n != 5", 0);
+
+    SECTION("exception carries the site id only")
+    {
+        try
+        {
+            check_positive(0);
+            CHECK(false);
+        }
+        catch (ctrx::precondition_violation const& e)
+        {
+            CHECK(e.site_id() == positive_id);
+            CHECK(e.what() == ctrx::detail::site_message(positive_id));
+            CHECK(e.source_location().line() == 0);
+            CHECK(e.type() == ctrx::contract_type::precondition);
+        }
+        try
+        {
+            check_non_negative(-1);
+            CHECK(false);
+        }
+        catch (ctrx::postcondition_violation const& e)
+        {
+            CHECK(e.type() == ctrx::contract_type::postcondition);
+        }
+    }
+    SECTION("batched conditions have their own site ids")
+    {
+        try
+        {
+            check_range(10);
+            CHECK(false);
+        }
+        catch (ctrx::precondition_violation const& e)
+        {
+            CHECK(e.site_id() == range_id);
+        }
+    }
+    SECTION("handler receives the site id")
+    {
+        handler_message.clear();
+        check_range(5);
+        CHECK(handler_message == ctrx::detail::site_message(assert_id));
+        CHECK(handler_sloc.line() == 0);
+    }
+    SECTION("snapshots report the site id of the snapshot")
+    {
+        auto const snapshot_id = ctrx::detail::hash_site(__FILE__, mutate_line, "table", 0);
+        int        table[3]    = {1, 2, 3};
+        handler_message.clear();
+        mutate(table);
+        CAPTURE(handler_message);
+        CHECK(handler_message.starts_with(ctrx::detail::site_message(snapshot_id)));
+    }
+    SECTION("error-return contracts return")
+    {
+        CHECK(seven_or_zero(7) == 7);
+        CHECK(seven_or_zero(8) == 0);
+    }
+    SECTION("site map rehydrates reports")
+    {
+        std::istringstream in(std::string(ctrx::format_site_id(positive_id).data())
+                              + "\tsrc/test_strip_strings.cpp\t42\tPRECONDITION\tDEFAULT\tn > 0\tn must be positive\n");
+        auto const map = ctrx::site_map::parse(in);
+        REQUIRE(map.has_value());
+        REQUIRE(map->find(positive_id) != nullptr);
+        CHECK(map->find(positive_id)->condition == "n > 0");
+        CHECK(map->find(range_id) == nullptr);
+        CHECK(map->rehydrate("error: " + ctrx::detail::site_message(positive_id) + "!")
+              == "error: src/test_strip_strings.cpp:42 PRECONDITION failure: n > 0 (n must be positive)!");
+        CHECK(map->rehydrate(ctrx::detail::site_message(range_id)) == ctrx::detail::site_message(range_id));
+    }
+    SECTION("site map rejects different contracts with the same id")
+    {
+        auto const in_dir = [&](std::string const& dir)
+        {
+            return std::string(ctrx::format_site_id(positive_id).data()) + "\tsrc/" + dir
+                 + "/util.cpp\t42\tPRECONDITION\tDEFAULT\tp != nullptr\t\n";
+        };
+        std::istringstream same(in_dir("a") + in_dir("a"));
+        CHECK(ctrx::site_map::parse(same).has_value());
+        std::istringstream different(in_dir("a") + in_dir("b"));
+        CHECK(!ctrx::site_map::parse(different).has_value());
+    }
+#if defined(CTRX_TEST_SITE_MAP)
+    SECTION("generated site map")
+    {
+        auto const map = ctrx::site_map::load(CTRX_TEST_SITE_MAP);
+        REQUIRE(map.has_value());
+        REQUIRE(map->find(positive_id) != nullptr);
+        CHECK(map->find(positive_id)->line == check_positive_line);
+        CHECK(map->find(positive_id)->condition == "n > 0");
+        CHECK(map->find(positive_id)->message == "n must be positive");
+        REQUIRE(map->find(range_id) != nullptr);
+        CHECK(map->find(range_id)->condition == "n < 10");
+        REQUIRE(map->find(assert_id) != nullptr);
+        CHECK(map->find(assert_id)->type == "ASSERTION");
+        auto const or_return_id = ctrx::detail::hash_site(__FILE__, seven_or_zero_line, "n == 7, o_1", 0);
+        REQUIRE(map->find(or_return_id) != nullptr);
+        CHECK(map->find(or_return_id)->condition == "n == 7");
+        CHECK(map->find(or_return_id)->level == "O_1");
+        auto const snapshot_id = ctrx::detail::hash_site(__FILE__, mutate_line, "table", 0);
+        REQUIRE(map->find(snapshot_id) != nullptr);
+        CHECK(map->find(snapshot_id)->type == "ASSERTION");
+        CHECK(map->find(snapshot_id)->condition == "table");
+    }
+#endif
+}
@@ -0,0 +1,95 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE TERMINATE
+#include "ctrx/contracts.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// A few template-heavy containers with contracts, instantiated for several types: every instantiation embeds its own
+// function name for the source location, unless strings are stripped
+template<typename T, std::size_t N>
+class ring_buffer
+{
+  public:
+    auto push(T const& value) -> void
+    {
+        CTRX_PRECONDITION(m_size < N, default, "ring buffer must not be full");
+        m_data[(m_head + m_size) % N] = value;
+        ++m_size;
+        CTRX_POSTCONDITION(m_size <= N);
+    }
+
+    auto pop() -> T
+    {
+        CTRX_PRECONDITION(m_size > 0, default, "ring buffer must not be empty");
+        T const value = m_data[m_head];
+        m_head        = (m_head + 1) % N;
+        --m_size;
+        return value;
+    }
+
+    [[nodiscard]] auto at(std::size_t i) const -> T const&
+    {
+        CTRX_PRECONDITIONS(i < m_size, m_head < N);
+        return m_data[(m_head + i) % N];
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        CTRX_ASSERT(m_size <= N && m_head < N, default, "ring buffer invariant broken");
+        return m_size;
+    }
+
+  private:
+    std::array<T, N> m_data{};
+    std::size_t      m_head = 0;
+    std::size_t      m_size = 0;
+};
+
+template<typename T, std::size_t N>
+auto exercise(int seed) -> int
+{
+    ring_buffer<T, N> buffer;
+    for (int i = 0; i < seed; ++i)
+        buffer.push(static_cast<T>(i));
+    int result = static_cast<int>(buffer.size());
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+        result += static_cast<int>(buffer.at(i));
+    return result + static_cast<int>(buffer.pop());
+}
+
+template<std::size_t N>
+auto exercise_all(int seed) -> int
+{
+    return exercise<std::int8_t, N>(seed) + exercise<std::int16_t, N>(seed) + exercise<std::int32_t, N>(seed)
+           + exercise<std::int64_t, N>(seed) + exercise<float, N>(seed) + exercise<double, N>(seed);
+}
+
+auto main(int argc, char**) -> int
+{
+    return exercise_all<4>(argc) + exercise_all<8>(argc) + exercise_all<16>(argc) + exercise_all<32>(argc) == 0 ? 1 : 0;
+}
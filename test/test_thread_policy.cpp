@@ -0,0 +1,96 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_LEVEL AUDIT
+#include "ctrx/contracts.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <thread>
+
+void audit_failure()
+{
+    CTRX_ASSERT(false, audit);
+}
+void o_n_failure()
+{
+    CTRX_ASSERT(false, o_n);
+}
+void default_failure()
+{
+    CTRX_ASSERT(false);
+}
+
+auto throws(void (*failure)()) -> bool
+{
+    try
+    {
+        failure();
+        return false;
+    }
+    catch (ctrx::assertion_violation const&)
+    {
+        return true;
+    }
+}
+
+TEST_CASE("thread policy", "[ctrx]", runtime)
+{
+    SECTION("scoped")
+    {
+        CHECK(throws(audit_failure));
+        {
+            ctrx::thread_policy const policy{ctrx::cost::o_1};
+            CHECK(ctrx::max_cost() == ctrx::cost::o_1);
+            CHECK_FALSE(throws(audit_failure));
+            CHECK_FALSE(throws(o_n_failure));
+            CHECK(throws(default_failure));
+            {
+                ctrx::thread_policy const nested{ctrx::cost::o_n};
+                CHECK(throws(o_n_failure));
+                CHECK_FALSE(throws(audit_failure));
+            }
+            CHECK_FALSE(throws(o_n_failure));
+        }
+        CHECK(ctrx::max_cost() == ctrx::cost::o_n2);
+        CHECK(throws(audit_failure));
+    }
+    SECTION("per thread")
+    {
+        ctrx::thread_policy const policy{ctrx::cost::o_1};
+        bool                      checked_on_other_thread = false;
+        std::thread{[&] { checked_on_other_thread = throws(audit_failure); }}.join();
+        CHECK(checked_on_other_thread);
+        CHECK_FALSE(throws(audit_failure));
+    }
+    SECTION("precedence over the global maximum")
+    {
+        ctrx::set_max_cost(ctrx::cost::o_1);
+        CHECK_FALSE(throws(audit_failure));
+        {
+            ctrx::thread_policy const policy{ctrx::cost::o_n2};
+            CHECK(throws(audit_failure));
+        }
+        ctrx::set_max_cost(ctrx::cost::o_n2);
+    }
+}
@@ -0,0 +1,59 @@
+#
+# MIT License
+#
+# Copyright (c) 2023 Jan Möller
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Checks that only the expensive, never failing contract of the soak run was demoted, and is no longer checked by the
+# build with the overrides applied.
+#
+#   cmake -D BINARY=<tiered soak> -D OVERRIDES=<header> -D PROFILE=<file> -P check_tier.cmake
+
+file(STRINGS ${OVERRIDES} overrides REGEX "^CTRX_SITE_OVERRIDE\\(")
+list(LENGTH overrides count)
+if (NOT count EQUAL 1)
+    message(FATAL_ERROR "Expected a single demoted site, got ${count}: ${overrides}")
+endif ()
+if (NOT overrides MATCHES "^CTRX_SITE_OVERRIDE\\(0x[0-9a-f]+, AUDIT\\) // soak\\.cpp:[0-9]+: std::is_sorted")
+    message(FATAL_ERROR "Unexpected site override: ${overrides}")
+endif ()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E env CTRX_PROFILE_OUTPUT=${PROFILE} ${BINARY} RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${BINARY} failed: ${result}")
+endif ()
+
+file(STRINGS ${PROFILE} sites REGEX "^0x")
+set(checked)
+foreach (site IN LISTS sites)
+    string(REPLACE "\t" ";" fields "${site}")
+    list(GET fields 2 violations)
+    list(GET fields 8 condition)
+    list(APPEND checked "${condition}")
+    if (condition MATCHES "^all_at_least" AND NOT violations EQUAL 20)
+        message(FATAL_ERROR "Expected 20 violations of ${condition}, got ${violations}")
+    endif ()
+endforeach ()
+if (NOT checked MATCHES "all_at_least" OR NOT checked MATCHES "n % 2 == 0")
+    message(FATAL_ERROR "Kept contracts weren't checked: ${checked}")
+endif ()
+if (checked MATCHES "std::is_sorted")
+    message(FATAL_ERROR "Demoted contract was still checked: ${checked}")
+endif ()
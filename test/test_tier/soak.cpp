@@ -0,0 +1,75 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#define CTRX_CONFIG_PROFILE
+#include "ctrx/contracts.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Expensive and never fails, so it is demoted
+auto sum_sorted(std::vector<int> const& v) -> long
+{
+    CTRX_PRECONDITION(std::is_sorted(v.begin(), v.end()));
+    return std::accumulate(v.begin(), v.end(), 0L);
+}
+
+auto all_at_least(std::vector<int> const& v, int limit) -> bool
+{
+    return std::all_of(v.begin(), v.end(), [&](int x) { return x >= limit; });
+}
+
+// Just as expensive, but fails now and then
+auto count_above(std::vector<int> const& v, int limit) -> long
+{
+    CTRX_PRECONDITION(all_at_least(v, limit));
+    return std::count_if(v.begin(), v.end(), [&](int x) { return x > limit; });
+}
+
+// Never fails, but too cheap to matter
+auto half(int n) -> int
+{
+    CTRX_PRECONDITION(n % 2 == 0);
+    return n / 2;
+}
+
+int main()
+{
+    std::vector<int> v(1000);
+    std::iota(v.begin(), v.end(), 0);
+
+    long result = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+        result += sum_sorted(v) + half(2 * i);
+        try
+        {
+            result += count_above(v, i % 100 == 0 ? 1 : 0);
+        }
+        catch (ctrx::precondition_violation const&)
+        {
+        }
+    }
+    return result > 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "ctrx/predicates.hpp"
+#include "ctrx/validated.hpp"
+
+#include <bugspray/bugspray.hpp>
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+
+struct positive
+{
+    constexpr auto operator()(int i) const { return ctrx::in_range(i, 1, std::numeric_limits<int>::max()); }
+};
+
+struct even
+{
+    constexpr auto operator()(int i) const -> bool { return i % 2 == 0; }
+};
+
+struct not_empty
+{
+    constexpr auto operator()(std::string const& s) const -> bool { return !s.empty(); }
+};
+
+using positive_int      = ctrx::validated<int, positive>;
+using positive_even_int = ctrx::validated<int, positive, even>;
+
+static_assert(!std::is_convertible_v<int, positive_int>);
+static_assert(std::is_convertible_v<positive_even_int, positive_int>);
+static_assert(std::is_convertible_v<positive_even_int, ctrx::validated<int, even, positive>>);
+static_assert(!std::is_convertible_v<positive_int, positive_even_int>);
+static_assert(std::is_convertible_v<positive_int, int>);
+static_assert(sizeof(positive_even_int) == sizeof(int));
+static_assert(ctrx::detail::type_name<positive>() == "positive");
+
+// Needs no precondition, as its argument has been checked
+constexpr auto half(ctrx::validated<int, even> i) -> int
+{
+    return *i / 2;
+}
+
+TEST_CASE("validated", "[ctrx]", runtime)
+{
+    positive_even_int const i{4};
+    CHECK(i.get() == 4);
+    CHECK(half(i) == 2);
+    CHECK(positive_int{i} == positive_int{4});
+    CHECK(ctrx::validate<positive>(3) == positive_int{3});
+
+    CHECK_THROWS_AS(ctrx::precondition_violation, positive_even_int{3});
+    CHECK_THROWS_AS(ctrx::precondition_violation, positive_even_int{-2});
+    CHECK_THROWS_AS(ctrx::precondition_violation, ctrx::validate<not_empty>(std::string{}));
+
+    try
+    {
+        static_cast<void>(positive_int{-7});
+        CHECK(false);
+    }
+    catch (ctrx::precondition_violation const& e)
+    {
+        CAPTURE(e.what());
+        CHECK(std::string_view{e.what()}.find("value -7 is not in [1, ") != std::string_view::npos);
+        CHECK(std::string_view{e.what()}.find("(positive)") != std::string_view::npos);
+    }
+
+    auto name = ctrx::validate<not_empty>(std::string{"ctrx"});
+    CHECK(name->size() == 4);
+    CHECK(std::move(name).release() == "ctrx");
+}
+
+TEST_CASE("validated (constexpr)", "[ctrx]", compiletime)
+{
+    positive_even_int const i{8};
+    CHECK(half(i) == 4);
+    CHECK(static_cast<int>(positive_int{i}) == 8);
+}
+EVAL_TEST_CASE("validated (constexpr)");
@@ -0,0 +1,202 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// A violation storm: many threads violate the same contracts at once, in THROW mode (preconditions), in HANDLER mode
+// (assertions) and as error returns, each of them executing the contract sites for the first time in a different order.
+// Every violation must be reported exactly once, on the thread that caused it. Built with ThreadSanitizer, this also
+// checks that the state ctrx keeps per site and per process (profiles, sampling, policies, shared counters) is
+// race-free.
+//
+//   ctrx-violation-storm [<threads> [<iterations>]]
+#undef CTRX_CONFIG_MODE
+#define CTRX_CONFIG_MODE_PRECONDITION THROW
+#define CTRX_CONFIG_MODE_POSTCONDITION THROW
+#define CTRX_CONFIG_MODE_ASSERTION HANDLER
+#define CTRX_CONFIG_MODE_INVARIANT HANDLER
+#include "ctrx/contracts.hpp"
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace
+{
+std::atomic<std::uint64_t> handled{0};
+std::atomic<std::uint64_t> handled_without_message{0};
+thread_local std::uint64_t handled_by_this_thread = 0;
+} // namespace
+
+namespace ctrx
+{
+void handle_contract_violation(contract_type, std::string_view message, std::source_location const&)
+{
+    if (message.empty())
+        handled_without_message.fetch_add(1, std::memory_order_relaxed);
+    handled.fetch_add(1, std::memory_order_relaxed);
+    ++handled_by_this_thread;
+}
+} // namespace ctrx
+
+namespace
+{
+// Each instantiation has contract sites of its own, which are executed for the first time by all threads at once
+template<std::size_t Site>
+auto parse(int value) -> int
+{
+    CTRX_PRECONDITION(value % 2 == 0, default, "odd value");
+    return value / 2;
+}
+
+template<std::size_t Site>
+auto store(int value) -> int
+{
+    CTRX_ASSERT(value % 3 != 0, default, "multiple of three");
+    return value;
+}
+
+template<std::size_t Site>
+auto lookup(int value) -> int
+{
+    CTRX_PRECONDITION_OR_RETURN(-1, value % 5 != 0);
+    return value;
+}
+
+constexpr std::size_t site_count = 16;
+
+struct counts
+{
+    std::uint64_t thrown   = 0;
+    std::uint64_t handled  = 0;
+    std::uint64_t returned = 0;
+
+    auto operator==(counts const&) const -> bool = default;
+};
+
+// Calls the site-th instantiation of the checks with value, and counts the violations it reports
+template<std::size_t... Sites>
+void hit(std::size_t site, int value, counts& c, std::index_sequence<Sites...>)
+{
+    (
+        [&]
+        {
+            if (Sites != site)
+                return;
+            try
+            {
+                parse<Sites>(value);
+            }
+            catch (ctrx::precondition_violation const&)
+            {
+                ++c.thrown;
+            }
+            store<Sites>(value);
+            if (lookup<Sites>(value) < 0)
+                ++c.returned;
+        }(),
+        ...);
+}
+
+auto expected_counts(std::size_t threads, int iterations) -> counts
+{
+    counts expected;
+    for (int i = 0; i < iterations; ++i)
+    {
+        expected.thrown += i % 2 != 0;
+        expected.handled += i % 3 == 0;
+        expected.returned += i % 5 == 0;
+    }
+    expected.thrown *= threads * site_count;
+    expected.handled *= threads * site_count;
+    expected.returned *= threads * site_count;
+    return expected;
+}
+
+auto expect(bool condition, char const* what) -> bool
+{
+    if (!condition)
+        std::cerr << "failed: " << what << '\n';
+    return condition;
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    std::size_t const threads    = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    int const         iterations = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    std::vector<counts>      reported(threads);
+    std::atomic<std::size_t> misattributed{0};
+    std::latch               start{static_cast<std::ptrdiff_t>(threads)};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(
+            [&, t]
+            {
+                counts c;
+                start.arrive_and_wait();
+                for (int i = 0; i < iterations; ++i)
+                    for (std::size_t s = 0; s < site_count; ++s)
+                        hit((s + t) % site_count, i, c, std::make_index_sequence<site_count>{});
+                c.handled = handled_by_this_thread;
+                if (c != expected_counts(1, iterations))
+                    misattributed.fetch_add(1, std::memory_order_relaxed);
+                reported[t] = c;
+            });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    counts total;
+    for (auto const& c : reported)
+    {
+        total.thrown += c.thrown;
+        total.handled += c.handled;
+        total.returned += c.returned;
+    }
+    auto const expected = expected_counts(threads, iterations);
+    bool       ok       = expect(total == expected, "every violation is reported once");
+    ok &= expect(handled.load() == expected.handled, "the handler is called once per violation");
+    ok &= expect(handled_without_message.load() == 0, "the handler gets the message");
+    ok &= expect(misattributed.load() == 0, "violations are reported on the thread that caused them");
+#if defined(CTRX_CONFIG_PROFILE)
+    std::uint64_t profiled = 0;
+    for (auto const& entry : ctrx::profile_report())
+        profiled += entry.violations;
+    ok &= expect(profiled == expected.thrown + expected.handled + expected.returned,
+                 "the profile counts every violation");
+#endif
+
+    std::cout << threads << " threads: " << total.thrown << " thrown, " << total.handled << " handled, "
+              << total.returned << " returned\n";
+    return ok ? 0 : 1;
+}
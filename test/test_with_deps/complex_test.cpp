@@ -25,6 +25,7 @@
 #include "libinterface.hpp"
 
 #include <bugspray/bugspray.hpp>
+#include <ctrx/configuration.hpp>
 #include <ctrx/contracts.hpp>
 
 #include <filesystem>
@@ -32,6 +33,9 @@
 
 extern auto bar(int) -> int;
 extern auto baz(int) -> int;
+extern auto qux(int) -> int;
+extern auto quux(int) -> int;
+extern auto liboff_configuration() noexcept -> ctrx::configuration;
 
 auto bam(int i) -> int
 {
@@ -149,4 +153,44 @@ TEST_CASE("check", "", runtime)
         std::filesystem::path p{e.source_location().file_name()};
         REQUIRE(p.filename().c_str() == "complex_test.cpp"sv);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("mixed configurations", "", runtime)
+{
+    using namespace std::string_view_literals;
+
+    constexpr ctrx::configuration::contract throw_default{"THROW", "DEFAULT"};
+    constexpr ctrx::configuration::contract off_default{"OFF", "DEFAULT"};
+    constexpr ctrx::configuration           throw_mode{throw_default, throw_default, throw_default, throw_default};
+    constexpr ctrx::configuration           off_mode{off_default, off_default, off_default, off_default};
+    CHECK(ctrx::build_configuration() == throw_mode);
+    CHECK(liboff_configuration() == off_mode);
+
+    // Each library runs its own definition of the inline function foo
+    CHECK(qux(0) == 0);
+    CHECK(qux(3) == 3);
+    try
+    {
+        foo(0);
+        CHECK(false);
+    }
+    catch (ctrx::precondition_violation const& e)
+    {
+        std::filesystem::path p{e.source_location().file_name()};
+        CHECK(p.filename().c_str() == "libinterface.hpp"sv);
+    }
+
+    // ... and of the constructor of validated
+    CHECK(quux(0) == 0);
+    try
+    {
+        [[maybe_unused]] non_zero_int const i{0};
+        CHECK(false);
+    }
+    catch (ctrx::precondition_violation const& e)
+    {
+        std::filesystem::path p{e.source_location().file_name()};
+        CHECK(p.filename().c_str() == "validated.hpp"sv);
+    }
+    CHECK(foo(non_zero_int{7}) == 7);
+}
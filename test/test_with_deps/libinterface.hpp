@@ -26,11 +26,26 @@
 #define CTRX_LIBINTERFACE_HPP
 
 #include <ctrx/contracts.hpp>
+#include <ctrx/validated.hpp>
 
-constexpr auto foo(int i) -> int
+// Tagged, as it is also compiled into liboff with contracts turned off
+CTRX_ABI constexpr auto foo(int i) -> int
 {
     CTRX_PRECONDITION(i != 0);
     return i;
 }
 
+struct non_zero
+{
+    constexpr auto operator()(int i) const -> bool { return i != 0; }
+};
+
+using non_zero_int = ctrx::validated<int, non_zero>;
+
+// Needs no check, as the argument carries the proof
+constexpr auto foo(non_zero_int i) -> int
+{
+    return *i;
+}
+
 #endif // CTRX_LIBINTERFACE_HPP
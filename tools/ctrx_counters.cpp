@@ -0,0 +1,274 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// Prints live rates of the contract counters a process built with CTRX_CONFIG_SHARED_COUNTERS keeps in shared memory.
+//
+//   ctrx-counters [-i <seconds>] [-n <count>] <pid|name>
+//
+// Attaches read-only to the segment /ctrx.<pid>, or the one named, and prints the violations and evaluations per second
+// of each contract site, every <seconds> (default 1) until it printed <count> samples (default: until interrupted). The
+// first sample shows the rates since the segment was created, the others those since the previous sample. Sites are
+// listed by descending violation rate.
+
+#include "ctrx/contract_type.hpp"
+#include "ctrx/shared_counters.hpp"
+#include "ctrx/site_id.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+// Read-only mapping of a counter segment
+class segment
+{
+  public:
+    explicit segment(std::string name)
+        : m_name(std::move(name))
+    {
+        int const fd = ::shm_open(m_name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + m_name + ": " + std::strerror(errno));
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(ctrx::shared_counters_header))
+        {
+            ::close(fd);
+            throw std::runtime_error(m_name + " is no ctrx counter segment");
+        }
+        m_size   = static_cast<std::size_t>(info.st_size);
+        m_memory = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (m_memory == MAP_FAILED)
+            throw std::runtime_error("cannot map " + m_name + ": " + std::strerror(errno));
+
+        auto const& h = header();
+        if (std::memcmp(h.magic, ctrx::shared_counters_magic, sizeof(h.magic)) != 0)
+            throw std::runtime_error(m_name + " is no ctrx counter segment");
+        if (h.version != ctrx::shared_counters_version || h.header_size != sizeof(ctrx::shared_counters_header)
+            || h.slot_size != sizeof(ctrx::shared_counter_slot))
+            throw std::runtime_error(m_name + " has layout version " + std::to_string(h.version) + ", expected "
+                                     + std::to_string(ctrx::shared_counters_version));
+        if (m_size < h.header_size + std::size_t{h.capacity} * h.slot_size)
+            throw std::runtime_error(m_name + " is truncated");
+    }
+
+    segment(segment const&)                    = delete;
+    auto operator=(segment const&) -> segment& = delete;
+
+    ~segment() { ::munmap(m_memory, m_size); }
+
+    [[nodiscard]] auto name() const -> std::string const& { return m_name; }
+
+    [[nodiscard]] auto header() const -> ctrx::shared_counters_header const&
+    {
+        return *static_cast<ctrx::shared_counters_header const*>(m_memory);
+    }
+
+    // The slots handed out so far, stopping at the first one that isn't ready yet
+    [[nodiscard]] auto slots() const -> std::vector<ctrx::shared_counter_slot const*>
+    {
+        auto const& h     = header();
+        auto const  used  = std::min(h.used.load(std::memory_order_acquire), h.capacity);
+        auto const* first = reinterpret_cast<ctrx::shared_counter_slot const*>(&h + 1);
+        std::vector<ctrx::shared_counter_slot const*> result;
+        for (std::uint32_t i = 0; i < used && first[i].ready.load(std::memory_order_acquire) != 0; ++i)
+            result.push_back(first + i);
+        return result;
+    }
+
+  private:
+    std::string m_name;
+    void*       m_memory = nullptr;
+    std::size_t m_size   = 0;
+};
+
+struct sample
+{
+    ctrx::shared_counter_slot const* slot;
+    std::uint64_t                    evaluations;
+    std::uint64_t                    violations;
+};
+
+auto take_samples(segment const& s) -> std::vector<sample>
+{
+    std::vector<sample> result;
+    for (auto const* slot : s.slots())
+        result.push_back({slot,
+                          slot->evaluations.load(std::memory_order_relaxed),
+                          slot->violations.load(std::memory_order_relaxed)});
+    return result;
+}
+
+auto type_name(std::uint8_t type) -> std::string_view
+{
+    switch (static_cast<ctrx::contract_type>(type))
+    {
+    case ctrx::contract_type::precondition: return "PRECONDITION";
+    case ctrx::contract_type::postcondition: return "POSTCONDITION";
+    case ctrx::contract_type::assertion: return "ASSERTION";
+    case ctrx::contract_type::invariant: return "INVARIANT";
+    }
+    return "?";
+}
+
+// Text of a fixed-size field, which may lack the terminating null if a writer were to fill it completely
+template<std::size_t N>
+auto text(char const (&field)[N]) -> std::string_view
+{
+    return {field, ::strnlen(field, N)};
+}
+
+auto now_ns() -> std::uint64_t
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count());
+}
+
+void print(segment const& s, std::vector<sample> const& previous, std::vector<sample> const& current, double seconds)
+{
+    struct rate
+    {
+        sample const* site;
+        double        violations;
+        double        evaluations;
+    };
+    std::vector<rate> rates;
+    for (std::size_t i = 0; i < current.size(); ++i)
+    {
+        // Slots are never reused, so the previous sample of a site is at the same index, if the site was there yet
+        auto const evaluations = current[i].evaluations - (i < previous.size() ? previous[i].evaluations : 0);
+        auto const violations  = current[i].violations - (i < previous.size() ? previous[i].violations : 0);
+        rates.push_back({&current[i],
+                         static_cast<double>(violations) / seconds,
+                         static_cast<double>(evaluations) / seconds});
+    }
+    std::stable_sort(rates.begin(),
+                     rates.end(),
+                     [](rate const& lhs, rate const& rhs)
+                     {
+                         if (lhs.violations != rhs.violations)
+                             return lhs.violations > rhs.violations;
+                         if (lhs.evaluations != rhs.evaluations)
+                             return lhs.evaluations > rhs.evaluations;
+                         return lhs.site->violations > rhs.site->violations;
+                     });
+
+    auto const& h = s.header();
+    std::cout << s.name() << " (pid " << h.pid << "): " << current.size() << " of " << h.capacity
+              << " sites, over " << std::fixed << std::setprecision(2) << seconds << " s\n";
+    std::cout << std::setw(14) << "violations/s" << std::setw(16) << "evaluations/s" << std::setw(14) << "violations"
+              << std::setw(16) << "evaluations"
+              << "  site                type           level      location\n";
+    for (auto const& r : rates)
+    {
+        auto const& slot = *r.site->slot;
+        std::cout << std::setw(14) << r.violations << std::setw(16) << r.evaluations << std::setw(14)
+                  << r.site->violations << std::setw(16) << r.site->evaluations << "  "
+                  << ctrx::format_site_id(slot.site).data() << "  " << std::left << std::setw(15)
+                  << type_name(slot.type) << std::setw(11) << text(slot.level) << std::right << text(slot.location)
+                  << '\n';
+    }
+    std::cout << std::flush;
+}
+
+auto usage() -> int
+{
+    std::cerr << "usage: ctrx-counters [-i <seconds>] [-n <count>] <pid|name>\n";
+    return 2;
+}
+
+auto run(std::vector<std::string_view> args) -> int
+{
+    double      interval = 1.0;
+    long        count    = 0;
+    std::string name;
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        bool const has_value = i + 1 < args.size();
+        if (args[i] == "-i" && has_value)
+            interval = std::stod(std::string(args[++i]));
+        else if (args[i] == "-n" && has_value)
+            count = std::stol(std::string(args[++i]));
+        else if (args[i].starts_with("-") || !name.empty())
+            return usage();
+        else
+            name = args[i];
+    }
+    if (name.empty() || interval <= 0.0 || count < 0)
+        return usage();
+    if (std::all_of(name.begin(), name.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        name = "/ctrx." + name;
+    else if (!name.starts_with("/"))
+        name = "/" + name;
+
+    segment const       s{name};
+    std::vector<sample> previous;
+    auto                previous_time = s.header().start_time;
+    for (long i = 0; count == 0 || i < count; ++i)
+    {
+        if (i > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+            std::cout << '\n';
+        }
+        auto const current = take_samples(s);
+        auto const time    = now_ns();
+        auto const elapsed = time > previous_time ? static_cast<double>(time - previous_time) * 1e-9 : 0.0;
+        print(s, previous, current, std::max(1e-3, elapsed));
+        previous      = current;
+        previous_time = time;
+    }
+    return 0;
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    try
+    {
+        return run(std::vector<std::string_view>(argv + 1, argv + argc));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ctrx-counters: " << e.what() << '\n';
+        return 1;
+    }
+}
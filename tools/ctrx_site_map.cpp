@@ -0,0 +1,549 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Generates the site map of builds with stripped strings (CTRX_CONFIG_STRIP_STRINGS), and rehydrates reports with it.
+//
+//   ctrx-site-map scan [-o <map>] <source>...   Writes the site map of all contracts in the given sources
+//   ctrx-site-map rehydrate <map> [<log>]       Replaces site ids in a log (or stdin) by the contract they identify
+//
+// The scanner reproduces what the preprocessor does to the arguments of the contract macros: comments become spaces,
+// line continuations are removed, whitespace between tokens becomes a single space and leading and trailing whitespace
+// is removed. The result is hashed like ctrx::detail::site_id() does.
+
+#include "ctrx/site_id.hpp"
+#include "ctrx/site_map.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include <cctype>
+#include <cstdint>
+
+namespace
+{
+struct contract_macro
+{
+    std::string_view name;
+    std::string_view type;       // empty if the type is the first macro argument
+    bool             batch;      // true if every argument is a condition
+    bool             skip_first; // true if the first macro argument isn't part of the contract (e.g. a period)
+};
+
+constexpr contract_macro contract_macros[] = {
+    {"CTRX_PRECONDITION", "PRECONDITION", false, false},
+    {"CTRX_POSTCONDITION", "POSTCONDITION", false, false},
+    {"CTRX_ASSERT", "ASSERTION", false, false},
+    {"CTRX_INVARIANT", "INVARIANT", false, false},
+    {"CTRX_INVARIANT_GUARD", "INVARIANT", false, false},
+    {"CTRX_INVARIANT_GUARD_ON_EXIT", "INVARIANT", false, false},
+    {"CTRX_INVARIANT_GUARD_SAMPLED", "INVARIANT", false, true},
+    {"CTRX_CONTRACT", "", false, true},
+    {"CTRX_PRECONDITIONS", "PRECONDITION", true, false},
+    {"CTRX_POSTCONDITIONS", "POSTCONDITION", true, false},
+    {"CTRX_ASSERTS", "ASSERTION", true, false},
+    {"CTRX_INVARIANTS", "INVARIANT", true, false},
+    {"CTRX_CONTRACTS", "", true, true},
+    {"CTRX_PRECONDITION_OR_RETURN", "PRECONDITION", false, true},
+    {"CTRX_PRECONDITION_OR_UNEXPECTED", "PRECONDITION", false, false},
+    {"CTRX_SNAPSHOT", "ASSERTION", false, false},
+};
+
+auto find_contract_macro(std::string_view name) -> contract_macro const*
+{
+    for (auto const& m : contract_macros)
+        if (m.name == name)
+            return &m;
+    return nullptr;
+}
+
+auto is_identifier_char(char c) -> bool
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+auto is_space(char c) -> bool
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+auto trim(std::string_view str) -> std::string_view
+{
+    while (!str.empty() && str.front() == ' ')
+        str.remove_prefix(1);
+    while (!str.empty() && str.back() == ' ')
+        str.remove_suffix(1);
+    return str;
+}
+
+auto to_upper(std::string_view str) -> std::string
+{
+    std::string result(str);
+    for (auto& c : result)
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return result;
+}
+
+// Messages are string literals; the map holds their contents
+auto unquote(std::string const& str) -> std::string
+{
+    if (str.size() >= 2 && str.front() == '"' && str.back() == '"')
+        return str.substr(1, str.size() - 2);
+    return str;
+}
+
+// Walks a source file after translation phase 2 (i.e. without line continuations), keeping track of the line numbers
+class source_reader
+{
+  public:
+    explicit source_reader(std::string text)
+        : m_text(std::move(text))
+    {
+        skip_continuations();
+    }
+
+    [[nodiscard]] auto done() const -> bool { return m_pos >= m_text.size(); }
+    [[nodiscard]] auto line() const -> std::size_t { return m_line; }
+    [[nodiscard]] auto peek(std::size_t offset = 0) const -> char
+    {
+        std::size_t pos = m_pos;
+        for (std::size_t i = 0; i <= offset; ++i)
+        {
+            while (pos + 1 < m_text.size() && m_text[pos] == '\\' && m_text[pos + 1] == '\n')
+                pos += 2;
+            if (i < offset)
+                ++pos;
+        }
+        return pos < m_text.size() ? m_text[pos] : '\0';
+    }
+
+    auto get() -> char
+    {
+        char const c = m_text[m_pos++];
+        if (c == '\n')
+            ++m_line;
+        skip_continuations();
+        return c;
+    }
+
+  private:
+    void skip_continuations()
+    {
+        while (m_pos + 1 < m_text.size() && m_text[m_pos] == '\\' && m_text[m_pos + 1] == '\n')
+        {
+            m_pos += 2;
+            ++m_line;
+        }
+    }
+
+    std::string m_text;
+    std::size_t m_pos  = 0;
+    std::size_t m_line = 1;
+};
+
+// Copies a string or character literal (including prefix-less raw strings if raw is set) verbatim to out
+void read_literal(source_reader& in, std::string& out, bool raw)
+{
+    char const quote = in.get();
+    out += quote;
+    if (raw)
+    {
+        std::string delimiter;
+        while (!in.done() && in.peek() != '(')
+        {
+            char const c = in.get();
+            delimiter += c;
+            out += c;
+        }
+        std::string const terminator = ")" + delimiter + "\"";
+        while (!in.done())
+        {
+            out += in.get();
+            if (out.size() >= terminator.size() && out.ends_with(terminator))
+                return;
+        }
+        return;
+    }
+    while (!in.done())
+    {
+        char const c = in.get();
+        out += c;
+        if (c == '\\' && !in.done())
+            out += in.get();
+        else if (c == quote || c == '\n')
+            return;
+    }
+}
+
+// Skips a comment (the reader is positioned at its leading slash)
+void skip_comment(source_reader& in)
+{
+    in.get();
+    if (in.get() == '/')
+    {
+        while (!in.done() && in.peek() != '\n')
+            in.get();
+        return;
+    }
+    while (!in.done() && !(in.peek() == '*' && in.peek(1) == '/'))
+        in.get();
+    if (!in.done())
+    {
+        in.get();
+        in.get();
+    }
+}
+
+auto at_comment(source_reader const& in) -> bool
+{
+    return in.peek() == '/' && (in.peek(1) == '/' || in.peek(1) == '*');
+}
+
+auto is_raw_string_prefix(std::string_view identifier) -> bool
+{
+    return identifier == "R" || identifier == "u8R" || identifier == "uR" || identifier == "UR" || identifier == "LR";
+}
+
+// Macro arguments as stringized by the preprocessor, and the positions of the commas that separate them
+struct macro_arguments
+{
+    std::string              text;
+    std::vector<std::size_t> commas;
+
+    [[nodiscard]] auto count() const -> std::size_t { return commas.size() + 1; }
+
+    [[nodiscard]] auto operator[](std::size_t i) const -> std::string
+    {
+        std::size_t const first = i == 0 ? 0 : commas[i - 1] + 1;
+        std::size_t const last  = i == commas.size() ? text.size() : commas[i];
+        return std::string(trim(std::string_view(text).substr(first, last - first)));
+    }
+
+    // The text of all arguments starting at the ith one, e.g. what __VA_ARGS__ is stringized to
+    [[nodiscard]] auto text_from(std::size_t i) const -> std::string
+    {
+        if (i == 0)
+            return text;
+        return std::string(trim(std::string_view(text).substr(commas[i - 1] + 1)));
+    }
+};
+
+// Reads parenthesized macro arguments (the reader is positioned at the opening parenthesis)
+auto read_arguments(source_reader& in) -> macro_arguments
+{
+    macro_arguments result;
+    std::string     identifier;
+    bool            pending_space = false;
+    int             depth         = 0;
+    in.get();
+    while (!in.done())
+    {
+        if (at_comment(in))
+        {
+            skip_comment(in);
+            pending_space = true;
+            identifier.clear();
+            continue;
+        }
+        char const c = in.peek();
+        if (is_space(c))
+        {
+            in.get();
+            pending_space = true;
+            identifier.clear();
+            continue;
+        }
+        if (c == ')' && depth == 0)
+        {
+            in.get();
+            break;
+        }
+
+        if (pending_space && !result.text.empty())
+            result.text += ' ';
+        pending_space = false;
+
+        if (c == '"' || c == '\'')
+        {
+            read_literal(in, result.text, c == '"' && is_raw_string_prefix(identifier));
+            identifier.clear();
+            continue;
+        }
+        if (c == ',' && depth == 0)
+            result.commas.push_back(result.text.size());
+        else if (c == '(')
+            ++depth;
+        else if (c == ')')
+            --depth;
+        if (is_identifier_char(c))
+            identifier += c;
+        else
+            identifier.clear();
+        result.text += in.get();
+    }
+    return result;
+}
+
+void scan(std::filesystem::path const& path, std::vector<ctrx::site_map::entry>& entries)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("cannot open " + path.string());
+    source_reader in(std::string(std::istreambuf_iterator<char>(file), {}));
+
+    std::string const file_name = path.filename().string();
+    bool              line_start = true;
+    while (!in.done())
+    {
+        char const c = in.peek();
+        if (at_comment(in))
+        {
+            skip_comment(in);
+            continue;
+        }
+        if (c == '"' || c == '\'')
+        {
+            std::string ignored;
+            read_literal(in, ignored, false);
+            line_start = false;
+            continue;
+        }
+        if (c == '#' && line_start)
+        {
+            // Skip preprocessor directives; contracts within macro definitions don't have a site of their own
+            while (!in.done() && in.peek() != '\n')
+            {
+                if (at_comment(in))
+                    skip_comment(in);
+                else
+                    in.get();
+            }
+            continue;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c)))
+        {
+            // pp-numbers may contain digit separators, which must not be mistaken for character literals
+            while (!in.done() && (is_identifier_char(in.peek()) || in.peek() == '.' || in.peek() == '\''))
+                in.get();
+            line_start = false;
+            continue;
+        }
+        if (!is_identifier_char(c))
+        {
+            if (c == '\n')
+                line_start = true;
+            else if (!is_space(c))
+                line_start = false;
+            in.get();
+            continue;
+        }
+
+        std::string       identifier;
+        auto const        line = static_cast<std::uint32_t>(in.line());
+        while (!in.done() && is_identifier_char(in.peek()))
+            identifier += in.get();
+        line_start = false;
+        if (in.peek() == '"' && is_raw_string_prefix(identifier))
+        {
+            std::string ignored;
+            read_literal(in, ignored, true);
+            continue;
+        }
+
+        auto const* macro = find_contract_macro(identifier);
+        if (macro == nullptr)
+            continue;
+        while (!in.done() && (is_space(in.peek()) || at_comment(in)))
+        {
+            if (at_comment(in))
+                skip_comment(in);
+            else
+                in.get();
+        }
+        if (in.peek() != '(')
+            continue;
+
+        auto const  arguments = read_arguments(in);
+        std::size_t first = macro->skip_first ? 1 : 0;
+        if (arguments.count() <= first)
+            continue;
+        std::string const type = macro->type.empty() ? to_upper(arguments[0]) : std::string(macro->type);
+        std::string const text = arguments.text_from(first);
+        if (macro->batch)
+        {
+            auto const count = static_cast<unsigned>(arguments.count() - first);
+            for (unsigned index = count; first < arguments.count(); ++first, --index)
+                entries.push_back({ctrx::detail::hash_site(file_name.c_str(), line, text.c_str(), index),
+                                   path.generic_string(),
+                                   line,
+                                   type,
+                                   "DEFAULT",
+                                   arguments[first],
+                                   ""});
+        }
+        else
+        {
+            auto const level   = arguments.count() > first + 1 ? to_upper(arguments[first + 1]) : "DEFAULT";
+            auto const message = arguments.count() > first + 2 ? unquote(arguments[first + 2]) : "";
+            entries.push_back({ctrx::detail::hash_site(file_name.c_str(), line, text.c_str(), 0),
+                               path.generic_string(),
+                               line,
+                               type,
+                               level,
+                               arguments[first],
+                               message});
+        }
+    }
+}
+
+// Removes the entries that were scanned more than once (e.g. headers listed along with several sources). Fails if two
+// different contracts share a site id, as their violations, overrides and policies couldn't be told apart.
+auto remove_duplicates(std::vector<ctrx::site_map::entry>& entries) -> bool
+{
+    auto const same_file = [](std::string const& lhs, std::string const& rhs)
+    {
+        std::error_code error;
+        return lhs == rhs
+            || std::filesystem::weakly_canonical(lhs, error) == std::filesystem::weakly_canonical(rhs, error);
+    };
+
+    std::unordered_map<ctrx::site_id_t, std::size_t> first;
+    std::vector<ctrx::site_map::entry>               unique;
+    bool                                             result = true;
+    for (auto& e : entries)
+    {
+        auto const [it, inserted] = first.try_emplace(e.id, unique.size());
+        if (inserted)
+        {
+            unique.push_back(std::move(e));
+            continue;
+        }
+        auto const& other = unique[it->second];
+        if (other.line == e.line && other.condition == e.condition && same_file(other.file, e.file))
+            continue;
+        std::cerr << "ctrx-site-map: " << other.file << ':' << other.line << " and " << e.file << ':' << e.line
+                  << " have the same site id " << ctrx::format_site_id(e.id).data()
+                  << "; move one of the contracts to another line\n";
+        result = false;
+    }
+    entries = std::move(unique);
+    return result;
+}
+
+auto usage() -> int
+{
+    std::cerr << "usage: ctrx-site-map scan [-o <map>] <source>...\n"
+                 "       ctrx-site-map rehydrate <map> [<log>]\n";
+    return 2;
+}
+
+auto run_scan(std::vector<std::string_view> args) -> int
+{
+    std::optional<std::filesystem::path> output;
+    std::vector<std::filesystem::path>   sources;
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        if (args[i] == "-o" && i + 1 < args.size())
+            output = args[++i];
+        else
+            sources.emplace_back(args[i]);
+    }
+    if (sources.empty())
+        return usage();
+
+    std::vector<ctrx::site_map::entry> entries;
+    for (auto const& source : sources)
+        scan(source, entries);
+    if (!remove_duplicates(entries))
+        return 1;
+
+    std::ostringstream map;
+    ctrx::site_map::write(map, entries);
+    if (!output)
+    {
+        std::cout << map.str();
+        return 0;
+    }
+    std::ofstream file(*output, std::ios::binary);
+    file << map.str();
+    return file ? 0 : 1;
+}
+
+auto run_rehydrate(std::vector<std::string_view> args) -> int
+{
+    if (args.empty() || args.size() > 2)
+        return usage();
+    auto const map = ctrx::site_map::load(std::string(args[0]));
+    if (!map)
+    {
+        std::cerr << "ctrx-site-map: cannot read " << args[0] << '\n';
+        return 1;
+    }
+
+    std::ifstream file;
+    if (args.size() == 2)
+    {
+        file.open(std::string(args[1]));
+        if (!file)
+        {
+            std::cerr << "ctrx-site-map: cannot read " << args[1] << '\n';
+            return 1;
+        }
+    }
+    std::istream& in = args.size() == 2 ? file : std::cin;
+    for (std::string line; std::getline(in, line);)
+        std::cout << map->rehydrate(line) << '\n';
+    return 0;
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    if (argc < 2)
+        return usage();
+    std::string_view const        command = argv[1];
+    std::vector<std::string_view> args(argv + 2, argv + argc);
+    try
+    {
+        if (command == "scan")
+            return run_scan(std::move(args));
+        if (command == "rehydrate")
+            return run_rehydrate(std::move(args));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ctrx-site-map: " << e.what() << '\n';
+        return 1;
+    }
+    return usage();
+}
@@ -0,0 +1,254 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Jan Möller
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Demotes contracts that are expensive but never failed, based on profiles recorded with CTRX_CONFIG_PROFILE.
+//
+//   ctrx-tier [-o <header>] [--level <level>] [--min-share <percent>] [--min-evaluations <n>] <profile>...
+//
+// The profiles (see ctrx::write_profile) are merged by site id (different contracts with the same id are an error). A
+// site is demoted to <level> (default AUDIT) if it never failed, was evaluated at least <n> times (default 1000) and
+// took at least <percent> (default 1) of the ticks spent checking contracts. The generated header holds a
+// CTRX_SITE_OVERRIDE(site id, level) line per demoted site and is applied by building with CTRX_CONFIG_SITE_OVERRIDES
+// naming it.
+
+#include "ctrx/site_id.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cctype>
+#include <cstdint>
+
+namespace
+{
+struct site
+{
+    ctrx::site_id_t     id;
+    std::uint_least64_t evaluations = 0;
+    std::uint_least64_t violations  = 0;
+    std::uint_least64_t ticks       = 0;
+    std::string         type;
+    std::string         level;
+    std::string         file;
+    std::string         line;
+    std::string         condition;
+};
+
+// Cost tiers of the contract levels, as in contracts.hpp
+struct level_tier
+{
+    std::string_view level;
+    int              tier;
+};
+
+constexpr level_tier level_tiers[] = {
+    {"DEFAULT", 1},
+    {"AUDIT", 5},
+    {"AXIOM", 6},
+    {"O_1", 1},
+    {"O_LOG_N", 2},
+    {"O_N", 3},
+    {"O_N_LOG_N", 4},
+    {"O_N2", 5},
+};
+
+auto find_tier(std::string_view level) -> std::optional<int>
+{
+    for (auto const& l : level_tiers)
+        if (l.level == level)
+            return l.tier;
+    return std::nullopt;
+}
+
+auto to_upper(std::string_view str) -> std::string
+{
+    std::string result(str);
+    for (auto& c : result)
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return result;
+}
+
+auto split(std::string_view line) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> fields;
+    for (std::size_t pos = 0;;)
+    {
+        auto const tab = line.find('\t', pos);
+        fields.push_back(line.substr(pos, tab == std::string_view::npos ? std::string_view::npos : tab - pos));
+        if (tab == std::string_view::npos)
+            return fields;
+        pos = tab + 1;
+    }
+}
+
+auto parse_number(std::string_view str, int base) -> std::uint_least64_t
+{
+    if (base == 16 && str.starts_with("0x"))
+        str.remove_prefix(2);
+    std::uint_least64_t value = 0;
+    auto const [end, error]   = std::from_chars(str.data(), str.data() + str.size(), value, base);
+    if (error != std::errc{} || end != str.data() + str.size() || str.empty())
+        throw std::runtime_error("malformed number: " + std::string(str));
+    return value;
+}
+
+// Adds the sites of a profile to sites
+void read_profile(std::string const& path, std::map<ctrx::site_id_t, site>& sites)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("cannot open " + path);
+    for (std::string line; std::getline(file, line);)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line.front() == '#')
+            continue;
+        auto const fields = split(line);
+        if (fields.size() != 9)
+            throw std::runtime_error("malformed profile " + path + ": " + line);
+
+        auto const id         = static_cast<ctrx::site_id_t>(parse_number(fields[0], 16));
+        auto [iter, inserted] = sites.try_emplace(id);
+        auto& entry           = iter->second;
+        if (inserted)
+        {
+            entry.id        = id;
+            entry.type      = fields[4];
+            entry.level     = fields[5];
+            entry.file      = fields[6];
+            entry.line      = fields[7];
+            entry.condition = fields[8];
+        }
+        else if (entry.file != fields[6] || entry.line != fields[7] || entry.condition != fields[8])
+        {
+            // Merging them would demote (or keep) both contracts on behalf of either one
+            throw std::runtime_error(entry.file + ":" + entry.line + " and " + std::string(fields[6]) + ":"
+                                     + std::string(fields[7]) + " have the same site id "
+                                     + ctrx::format_site_id(id).data() + "; move one of the contracts to another line");
+        }
+        entry.evaluations += parse_number(fields[1], 10);
+        entry.violations += parse_number(fields[2], 10);
+        entry.ticks += parse_number(fields[3], 10);
+    }
+}
+
+auto usage() -> int
+{
+    std::cerr << "usage: ctrx-tier [-o <header>] [--level <level>] [--min-share <percent>] [--min-evaluations <n>] "
+                 "<profile>...\n";
+    return 2;
+}
+
+auto run(std::vector<std::string_view> args) -> int
+{
+    std::optional<std::string> output;
+    std::string                level           = "AUDIT";
+    double                     min_share       = 1.0;
+    std::uint_least64_t        min_evaluations = 1000;
+    std::vector<std::string>   profiles;
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        bool const has_value = i + 1 < args.size();
+        if (args[i] == "-o" && has_value)
+            output = args[++i];
+        else if (args[i] == "--level" && has_value)
+            level = to_upper(args[++i]);
+        else if (args[i] == "--min-share" && has_value)
+            min_share = std::stod(std::string(args[++i]));
+        else if (args[i] == "--min-evaluations" && has_value)
+            min_evaluations = parse_number(args[++i], 10);
+        else if (args[i].starts_with("-"))
+            return usage();
+        else
+            profiles.emplace_back(args[i]);
+    }
+    auto const target_tier = find_tier(level);
+    if (profiles.empty() || !target_tier || *target_tier == 1)
+        return usage();
+
+    std::map<ctrx::site_id_t, site> sites;
+    for (auto const& profile : profiles)
+        read_profile(profile, sites);
+
+    double total_ticks = 0.0;
+    for (auto const& [id, s] : sites)
+        total_ticks += static_cast<double>(s.ticks);
+
+    std::vector<std::pair<double, site const*>> demoted;
+    for (auto const& [id, s] : sites)
+    {
+        double const share = total_ticks == 0.0 ? 0.0 : 100.0 * static_cast<double>(s.ticks) / total_ticks;
+        auto const   tier  = find_tier(s.level);
+        if (s.violations == 0 && s.evaluations >= min_evaluations && share >= min_share && tier && *tier < *target_tier)
+            demoted.emplace_back(share, &s);
+    }
+    std::sort(demoted.begin(), demoted.end(), [](auto const& lhs, auto const& rhs) { return lhs.first > rhs.first; });
+
+    std::ostringstream header;
+    header << "// Generated by ctrx-tier from " << profiles.size() << " profile(s) of " << sites.size()
+           << " contract sites.\n// Demoted to " << level << ": sites that never failed in at least " << min_evaluations
+           << " evaluations and took at least " << min_share << "% of the checking time.\n"
+           << "// Applied by building with CTRX_CONFIG_SITE_OVERRIDES naming this file.\n";
+    header << std::fixed << std::setprecision(2);
+    for (auto const& [share, s] : demoted)
+    {
+        // The comment doesn't end with the condition, which might end with a backslash
+        header << "CTRX_SITE_OVERRIDE(" << ctrx::format_site_id(s->id).data() << ", " << level << ") // "
+               << ctrx::detail::basename(s->file.c_str()) << ':' << s->line << ": " << s->condition << " (" << s->type
+               << ' ' << s->level << ", " << share << "% of ticks, " << s->evaluations << " evaluations)\n";
+    }
+
+    if (!output)
+    {
+        std::cout << header.str();
+        return 0;
+    }
+    std::ofstream file(*output, std::ios::binary);
+    file << header.str();
+    return file ? 0 : 1;
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    try
+    {
+        return run(std::vector<std::string_view>(argv + 1, argv + argc));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ctrx-tier: " << e.what() << '\n';
+        return 1;
+    }
+}